@@ -48,7 +48,8 @@ using std::for_each, std::to_string, utilities::string_operations::Append,
 template<int para_dim>
 SplineEntry CreateSpline(SplineDataInt const& spline_data_int,
                          SplineDataDouble const& spline_data_double,
-                         int const& knot_vector_start);
+                         int const& knot_vector_start,
+                         SharedPointer<utilities::Arena> const& arena);
 
 int WriteSection(OutputStream& file,
                  String const& section_content,
@@ -72,7 +73,8 @@ String MakeBlock(String const& raw_string,
 
 } // namespace
 
-Splines Read(String const& file_name) {
+Splines Read(String const& file_name,
+             SharedPointer<utilities::Arena> const& arena) {
   using SplineSection = std::pair<Index, int>;
   using utilities::containers::GetValue,
       utilities::string_operations::ConvertToNumbers,
@@ -129,10 +131,16 @@ Splines Read(String const& file_name) {
                      ',');
              if (*spline_data_int.begin() == 126) {
                splines.push_back(
-                   CreateSpline<1>(spline_data_int, spline_data_double, 7));
+                   CreateSpline<1>(spline_data_int,
+                                   spline_data_double,
+                                   7,
+                                   arena));
              } else {
                splines.push_back(
-                   CreateSpline<2>(spline_data_int, spline_data_double, 10));
+                   CreateSpline<2>(spline_data_int,
+                                   spline_data_double,
+                                   10,
+                                   arena));
              }
            });
   return splines;
@@ -301,7 +309,8 @@ namespace {
 template<int para_dim>
 SplineEntry CreateSpline(SplineDataInt const& spline_data_int,
                          SplineDataDouble const& spline_data_double,
-                         int const& knot_vector_start) {
+                         int const& knot_vector_start,
+                         SharedPointer<utilities::Arena> const& arena) {
   using BSpline = BSpline<para_dim>;
   using Nurbs = Nurbs<para_dim>;
   using ParameterSpace = typename BSpline::ParameterSpace_;
@@ -309,13 +318,13 @@ SplineEntry CreateSpline(SplineDataInt const& spline_data_int,
   using WeightedVectorSpace = typename Nurbs::WeightedVectorSpace_;
   using KnotVectors = typename ParameterSpace::KnotVectors_;
   using KnotVector = typename KnotVectors::value_type::element_type;
-  using std::make_shared;
+  using utilities::MakeShared;
 
   auto iter_fill = [](auto& to, auto& iter, const auto offset) {
     using ToType = typename std::remove_reference_t<decltype(to)>::value_type;
-    ToType typed_offset{offset};
+    const ToType typed_offset{static_cast<ToType>(offset)};
     for (auto& to_elem : to) {
-      to_elem = ToType{*(iter++) + typed_offset};
+      to_elem = static_cast<ToType>(*(iter++) + typed_offset);
     }
   };
 
@@ -332,19 +341,20 @@ SplineEntry CreateSpline(SplineDataInt const& spline_data_int,
       spline_data_double.begin() + knot_vector_start};
   KnotVectors knot_vectors;
   for (int i{}; i < para_dim; ++i) {
-    auto& knot_vector = knot_vectors[i];
-    knot_vector = make_shared<KnotVector>();
-    Vector<double>& knots = knot_vector->GetKnots();
-    knots.resize(number_of_coordinates[i] + degrees[i] + 1);
+    typename KnotVector::Knots_ knots(
+        number_of_coordinates[i] + degrees[i] + 1);
     iter_fill(knots, spline_datum_double, 0.0);
+    knot_vectors[i] = MakeShared<KnotVector>(arena, std::move(knots));
   }
 
   // create para space
   SharedPointer<ParameterSpace> parameter_space{
-      make_shared<ParameterSpace>(std::move(knot_vectors), std::move(degrees))};
+      MakeShared<ParameterSpace>(arena,
+                                 std::move(knot_vectors),
+                                 std::move(degrees))};
 
   // now vector space
-  int const& total_number_of_coordinates =
+  Index const& total_number_of_coordinates =
       parameter_space->GetTotalNumberOfBasisFunctions();
   typename WeightedVectorSpace::Weights_ weights(total_number_of_coordinates);
   iter_fill(weights, spline_datum_double, 0.0);
@@ -355,14 +365,17 @@ SplineEntry CreateSpline(SplineDataInt const& spline_data_int,
   iter_fill(coordinates, spline_datum_double, 0.0);
 
   if (*(spline_datum_int + 2) == 1) {
-    return make_shared<BSpline>(
+    return MakeShared<BSpline>(
+        arena,
         std::move(parameter_space),
-        make_shared<VectorSpace>(std::move(coordinates)));
+        MakeShared<VectorSpace>(arena, std::move(coordinates)));
   } else {
-    return make_shared<Nurbs>(
+    return MakeShared<Nurbs>(
+        arena,
         std::move(parameter_space),
-        make_shared<WeightedVectorSpace>(std::move(coordinates),
-                                         std::move(weights)));
+        MakeShared<WeightedVectorSpace>(arena,
+                                        std::move(coordinates),
+                                        std::move(weights)));
   }
 }
 
@@ -29,9 +29,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 //
 // Example:
 //   Splines const &splines = Read("input.iges");
+//   // Splines and spaces of a (large) model in one arena, freed all at once
+//   // when the last of them is destroyed or explicitly released afterwards.
+//   auto const arena = std::make_shared<Arena>();
+//   Splines model = Read("model.iges", arena);
+//   model.clear();
+//   arena->Release();
 namespace bsplinelib::input_output::iges {
 
-Splines Read(String const& file_name);
+Splines Read(String const& file_name,
+             SharedPointer<utilities::Arena> const& arena = {});
 void Write(Splines const& splines,
            String const& file_name,
            Precision const& precision = kPrecision);
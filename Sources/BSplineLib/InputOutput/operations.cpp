@@ -38,10 +38,11 @@ FileFormat DetermineFileFormat(String const& file_name) {
   }
 }
 
-Splines Read(String const& file_name) {
+Splines Read(String const& file_name,
+             SharedPointer<utilities::Arena> const& arena) {
   switch (DetermineFileFormat(file_name)) {
   case FileFormat::kIges:
-    return iges::Read(file_name);
+    return iges::Read(file_name, arena);
     break;
   default: // case FileFormat::kInvalid
     return Splines{};
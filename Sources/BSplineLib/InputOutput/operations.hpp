@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Splines/b_spline.hpp"
 #include "BSplineLib/Splines/nurbs.hpp"
 #include "BSplineLib/Splines/spline_item.hpp"
+#include "BSplineLib/Utilities/arena.hpp"
 #include "BSplineLib/Utilities/containers.hpp"
 #include "BSplineLib/Utilities/error_handling.hpp"
 #include "BSplineLib/Utilities/string_operations.hpp"
@@ -47,7 +48,10 @@ using SplineEntry = SharedPointer<splines::SplineItem>;
 using Splines = Vector<SplineEntry>;
 
 FileFormat DetermineFileFormat(String const& file_name);
-Splines Read(String const& file_name);
+// Splines, their spaces and knot vectors are created in the arena if given,
+// their knot, coordinate and weight buffers on the heap.
+Splines Read(String const& file_name,
+             SharedPointer<utilities::Arena> const& arena = {});
 
 template<int para_dim, bool is_rational>
 auto CastToSpline(SplineEntry const& spline_entry);
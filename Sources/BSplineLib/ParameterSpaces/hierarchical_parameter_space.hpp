@@ -0,0 +1,187 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_PARAMETERSPACES_HIERARCHICAL_PARAMETER_SPACE_HPP_
+#define SOURCES_PARAMETERSPACES_HIERARCHICAL_PARAMETER_SPACE_HPP_
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/Utilities/named_type.hpp"
+
+namespace bsplinelib::parameter_spaces {
+
+/// @brief HierarchicalParameterSpaces provide truncated hierarchical B-spline
+/// (THB) bases for local refinement. Level 0 is the given parameter space,
+/// level l+1 is obtained by bisecting all elements of level l. The subdomain
+/// of level l+1 is the union of refined elements of level l. A basis function
+/// of level l is active if its support is contained in the subdomain of level
+/// l but not in the one of level l+1 (Kraft's selection). Active functions are
+/// truncated w.r.t. finer levels, i.e., they form a partition of unity.
+///
+/// Truncated functions are stored as sparse combinations of B-splines of
+/// their own and finer levels. Only B-splines overlapping refined regions are
+/// expanded. Each level keeps its complete parameter space and per-function
+/// supports though, i.e., level l stores as much as the parameter space
+/// refined uniformly l times. RefineElements rebuilds the basis from scratch:
+/// it checks the support of every B-spline of level 0 and of every candidate
+/// of finer levels, and truncates every active function again. Its cost
+/// grows with the total number of active functions, not with the number of
+/// refined elements.
+///
+/// Elements and basis functions of a level are addressed by flat indices with
+/// the first dimension running fastest, i.e., the same way as coordinates of
+/// splines.
+///
+/// Example:
+///   HierarchicalParameterSpace<2> hierarchical{parameter_space};
+///   hierarchical.RefineElements(0, {0, 1});  // Refines two elements.
+///   auto const& [functions, values] =
+///       hierarchical.EvaluateBasisValues(parametric_coordinate);
+/// @tparam para_dim
+template<int para_dim>
+class HierarchicalParameterSpace {
+public:
+  using ParameterSpace_ = ParameterSpace<para_dim>;
+  using Type_ = typename ParameterSpace_::Type_;
+  using IntType_ = typename ParameterSpace_::IntType_;
+  using SparseMatrix_ = typename ParameterSpace_::SparseMatrix_;
+  using Elements_ = Vector<int>;
+  using NumberOfElements_ = Array<int, para_dim>;
+  // (level, flat index of the B-spline of that level)
+  using BasisFunction_ = Tuple<int, int>;
+  using BasisFunctions_ = Vector<BasisFunction_>;
+  // indices of the non-zero active functions and their values
+  using BasisValues_ = Tuple<Vector<int>, Vector<Type_>>;
+
+  HierarchicalParameterSpace() = default;
+  explicit HierarchicalParameterSpace(ParameterSpace_ const& parameter_space,
+                                      Tolerance const& tolerance = kEpsilon);
+  HierarchicalParameterSpace(HierarchicalParameterSpace const& other) = default;
+  HierarchicalParameterSpace(HierarchicalParameterSpace&& other) noexcept =
+      default;
+  HierarchicalParameterSpace&
+  operator=(HierarchicalParameterSpace const& rhs) = default;
+  HierarchicalParameterSpace&
+  operator=(HierarchicalParameterSpace&& rhs) noexcept = default;
+  virtual ~HierarchicalParameterSpace() = default;
+
+  virtual int GetNumberOfLevels() const;
+  /// @brief Levels are never modified once created and may be shared.
+  /// @param level
+  /// @return
+  virtual SharedPointer<ParameterSpace_ const> const&
+  GetLevel(int const& level) const;
+  virtual NumberOfElements_ const& GetNumberOfElements(int const& level) const;
+  /// @brief Sorted flat indices of refined elements of given level.
+  /// @param level
+  /// @return
+  virtual Elements_ const& GetRefinedElements(int const& level) const;
+  /// @brief Whether an element of given level belongs to the subdomain of the
+  /// level but is not refined, i.e., is an element of the hierarchical mesh.
+  /// @param level
+  /// @param element flat element index of the level
+  /// @return
+  virtual bool IsElementActive(int const& level, int const& element) const;
+
+  virtual Index GetTotalNumberOfBasisFunctions() const;
+  virtual BasisFunctions_ const& GetBasisFunctions() const;
+  /// @brief Coefficients of the truncated active functions w.r.t. B-splines of
+  /// given level. Rows correspond to GetRepresentedFunctions(level), columns to
+  /// active functions.
+  /// @param level
+  /// @return
+  virtual SparseMatrix_ const& GetRepresentation(int const& level) const;
+  virtual Vector<int> const& GetRepresentedFunctions(int const& level) const;
+
+  /// @brief Refines given elements of given level, creating the next level if
+  /// necessary. Elements have to belong to the subdomain of the level.
+  /// @param level
+  /// @param elements flat element indices of the level
+  virtual void RefineElements(int const& level, Elements_ const& elements);
+
+  virtual BasisValues_
+  EvaluateBasisValues(const Type_* parametric_coordinate,
+                      Tolerance const& tolerance = kEpsilon) const;
+  virtual BasisValues_
+  EvaluateBasisDerivativeValues(const Type_* parametric_coordinate,
+                                const IntType_* derivative,
+                                Tolerance const& tolerance = kEpsilon) const;
+
+protected:
+  struct Level_ {
+    SharedPointer<ParameterSpace_ const> parameter_space_;
+    NumberOfElements_ number_of_elements_;
+    Array<typename ParameterSpace_::ElementSpans_, para_dim> element_spans_;
+    // elements of the support of each B-spline per dimension: [begin, end)
+    Array<Vector<int>, para_dim> support_begins_, support_ends_;
+    // coarse B-spline -> B-splines of the next level (transposed prolongation)
+    Array<SparseMatrix_, para_dim> children_;
+    Elements_ refined_elements_;
+    // truncated active functions in terms of B-splines of this level
+    Vector<int> represented_functions_;
+    SparseMatrix_ representation_;
+  };
+
+  // Levels and active functions are never modified but replaced, i.e., copies
+  // of hierarchical parameter spaces share them and are cheap.
+  Tolerance tolerance_{kEpsilon};
+  Vector<SharedPointer<Level_ const>> levels_;
+  SharedPointer<BasisFunctions_ const> basis_functions_{
+      std::make_shared<BasisFunctions_ const>()};
+
+private:
+  using Box_ = Array<Array<int, 2>, para_dim>;
+
+  void AddLevel(Level_& level) const;
+  void UpdateBasis();
+
+  Box_ DetermineSupport(int const& level, int const& function) const;
+  // length is given either per element (int) or per basis function (Length)
+  template<typename LengthType>
+  int DetermineFlatIndex(Array<int, para_dim> const& index,
+                         Array<LengthType, para_dim> const& length) const;
+  // subdomain of level l+1 is the union of the refined elements of level l
+  bool IsRefined(int const& level, int const& element) const;
+  bool IsInSubdomain(int const& level, int const& element) const;
+  // predicate(element) for all elements of the box
+  template<typename Predicate>
+  bool
+  AllOf(int const& level, Box_ const& box, Predicate const& predicate) const;
+
+  template<typename EvaluatePerDimension>
+  BasisValues_
+  CombineLevels(const Type_* parametric_coordinate,
+                EvaluatePerDimension const& evaluate_per_dimension,
+                Tolerance const& tolerance) const;
+
+  void ThrowIfLevelIsInvalid(int const& level) const;
+};
+
+#include "BSplineLib/ParameterSpaces/hierarchical_parameter_space.inl"
+
+} // namespace bsplinelib::parameter_spaces
+
+#endif // SOURCES_PARAMETERSPACES_HIERARCHICAL_PARAMETER_SPACE_HPP_
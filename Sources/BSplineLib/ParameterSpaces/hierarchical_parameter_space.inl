@@ -0,0 +1,575 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<int para_dim>
+HierarchicalParameterSpace<para_dim>::HierarchicalParameterSpace(
+    ParameterSpace_ const& parameter_space,
+    Tolerance const& tolerance)
+    : tolerance_{tolerance} {
+  auto level = std::make_shared<Level_>();
+  level->parameter_space_ = std::make_shared<ParameterSpace_>(parameter_space);
+  AddLevel(*level);
+  levels_.push_back(std::move(level));
+  UpdateBasis();
+}
+
+template<int para_dim>
+int HierarchicalParameterSpace<para_dim>::GetNumberOfLevels() const {
+  return static_cast<int>(levels_.size());
+}
+
+template<int para_dim>
+SharedPointer<typename HierarchicalParameterSpace<para_dim>::ParameterSpace_
+                  const> const&
+HierarchicalParameterSpace<para_dim>::GetLevel(int const& level) const {
+  ThrowIfLevelIsInvalid(level);
+  return levels_[level]->parameter_space_;
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::NumberOfElements_ const&
+HierarchicalParameterSpace<para_dim>::GetNumberOfElements(
+    int const& level) const {
+  ThrowIfLevelIsInvalid(level);
+  return levels_[level]->number_of_elements_;
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::Elements_ const&
+HierarchicalParameterSpace<para_dim>::GetRefinedElements(
+    int const& level) const {
+  ThrowIfLevelIsInvalid(level);
+  return levels_[level]->refined_elements_;
+}
+
+template<int para_dim>
+bool HierarchicalParameterSpace<para_dim>::IsElementActive(
+    int const& level,
+    int const& element) const {
+  ThrowIfLevelIsInvalid(level);
+  return IsInSubdomain(level, element) && !IsRefined(level, element);
+}
+
+template<int para_dim>
+Index HierarchicalParameterSpace<para_dim>::GetTotalNumberOfBasisFunctions()
+    const {
+  return static_cast<Index>(basis_functions_->size());
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::BasisFunctions_ const&
+HierarchicalParameterSpace<para_dim>::GetBasisFunctions() const {
+  return *basis_functions_;
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::SparseMatrix_ const&
+HierarchicalParameterSpace<para_dim>::GetRepresentation(
+    int const& level) const {
+  ThrowIfLevelIsInvalid(level);
+  return levels_[level]->representation_;
+}
+
+template<int para_dim>
+Vector<int> const&
+HierarchicalParameterSpace<para_dim>::GetRepresentedFunctions(
+    int const& level) const {
+  ThrowIfLevelIsInvalid(level);
+  return levels_[level]->represented_functions_;
+}
+
+template<int para_dim>
+void HierarchicalParameterSpace<para_dim>::RefineElements(
+    int const& level,
+    Elements_ const& elements) {
+  ThrowIfLevelIsInvalid(level);
+
+  int number_of_elements{1};
+  for (int const& n : levels_[level]->number_of_elements_) {
+    number_of_elements *= n;
+  }
+  for (int const& element : elements) {
+    if (element < 0 || element >= number_of_elements) {
+      throw OutOfRange("HierarchicalParameterSpace::RefineElements - element "
+                       + std::to_string(element) + " does not exist on level "
+                       + std::to_string(level) + ".");
+    }
+    if (!IsInSubdomain(level, element)) {
+      throw DomainError(
+          "HierarchicalParameterSpace::RefineElements - element "
+          + std::to_string(element) + " of level " + std::to_string(level)
+          + " is not part of the level's subdomain.");
+    }
+  }
+  if (elements.empty()) {
+    return;
+  }
+
+  if (level + 1 == GetNumberOfLevels()) {
+    // levels may be shared with copies, i.e., are replaced rather than modified
+    auto coarse = std::make_shared<Level_>(*levels_.back());
+    auto fine = std::make_shared<ParameterSpace_>(*coarse->parameter_space_);
+    for (int i{}; i < para_dim; ++i) {
+      // bisects all elements
+      KnotVector const& knot_vector =
+          *coarse->parameter_space_->GetKnotVector(i);
+      const Type_* knots = knot_vector.GetData();
+      Refinement refinement;
+      for (int const& span : coarse->element_spans_[i]) {
+        refinement.knots_.push_back(0.5 * (knots[span] + knots[span + 1]));
+      }
+      coarse->children_[i] =
+          fine->Refine(Dimension{i}, refinement, tolerance_).Transpose();
+    }
+    levels_.back() = std::move(coarse);
+    auto next = std::make_shared<Level_>();
+    next->parameter_space_ = std::move(fine);
+    AddLevel(*next);
+    levels_.push_back(std::move(next));
+  }
+
+  auto refined = std::make_shared<Level_>(*levels_[level]);
+  Elements_& refined_elements = refined->refined_elements_;
+  refined_elements.insert(refined_elements.end(),
+                          elements.begin(),
+                          elements.end());
+  std::sort(refined_elements.begin(), refined_elements.end());
+  refined_elements.erase(
+      std::unique(refined_elements.begin(), refined_elements.end()),
+      refined_elements.end());
+  levels_[level] = std::move(refined);
+
+  UpdateBasis();
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::BasisValues_
+HierarchicalParameterSpace<para_dim>::EvaluateBasisValues(
+    const Type_* parametric_coordinate,
+    Tolerance const& tolerance) const {
+  return CombineLevels(
+      parametric_coordinate,
+      [&](ParameterSpace_ const& parameter_space) {
+        return parameter_space.EvaluateBasisValuesPerDimension(
+            parametric_coordinate,
+            tolerance);
+      },
+      tolerance);
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::BasisValues_
+HierarchicalParameterSpace<para_dim>::EvaluateBasisDerivativeValues(
+    const Type_* parametric_coordinate,
+    const IntType_* derivative,
+    Tolerance const& tolerance) const {
+  return CombineLevels(
+      parametric_coordinate,
+      [&](ParameterSpace_ const& parameter_space) {
+        return parameter_space.EvaluateBasisDerivativeValuesPerDimension(
+            parametric_coordinate,
+            derivative,
+            tolerance);
+      },
+      tolerance);
+}
+
+// Determines elements and supports of a new level.
+template<int para_dim>
+void HierarchicalParameterSpace<para_dim>::AddLevel(Level_& level) const {
+  ParameterSpace_ const& parameter_space = *level.parameter_space_;
+  for (int i{}; i < para_dim; ++i) {
+    auto& element_spans = level.element_spans_[i];
+    element_spans = parameter_space.DetermineElementSpans(Dimension{i},
+                                                          tolerance_);
+    level.number_of_elements_[i] = static_cast<int>(element_spans.size());
+
+    const int degree = parameter_space.GetDegree(i);
+    const int number_of_basis_functions =
+        parameter_space.GetNumberOfBasisFunctions()[i];
+    auto &begins = level.support_begins_[i], &ends = level.support_ends_[i];
+    begins.resize(number_of_basis_functions);
+    ends.resize(number_of_basis_functions);
+    for (int function{}; function < number_of_basis_functions; ++function) {
+      // B-spline i is supported on the knot spans [i, i+p]
+      begins[function] = static_cast<int>(
+          std::lower_bound(element_spans.begin(), element_spans.end(), function)
+          - element_spans.begin());
+      ends[function] = static_cast<int>(std::upper_bound(element_spans.begin(),
+                                                         element_spans.end(),
+                                                         function + degree)
+                                        - element_spans.begin());
+    }
+  }
+}
+
+// Selects the active functions level by level and truncates them.  A B-spline
+// of level m is only expanded into B-splines of level m+1 if its support
+// overlaps the subdomain of level m+1, of which those supported within the
+// subdomain are dropped.
+template<int para_dim>
+void HierarchicalParameterSpace<para_dim>::UpdateBasis() {
+  using Entries = std::map<int, Vector<std::pair<int, Type_>>>;
+
+  const int number_of_levels = GetNumberOfLevels();
+  auto const not_refined = [&](int const& level) {
+    return [&, level](int const& element) {
+      return !IsRefined(level, element);
+    };
+  };
+  auto const in_subdomain = [&](int const& level) {
+    return [&, level](int const& element) {
+      return IsInSubdomain(level, element);
+    };
+  };
+
+  // active functions
+  BasisFunctions_ basis_functions;
+  for (int l{}; l < number_of_levels; ++l) {
+    Level_ const& level = *levels_[l];
+    ParameterSpace_ const& parameter_space = *level.parameter_space_;
+    auto const number_of_basis_functions =
+        parameter_space.GetNumberOfBasisFunctions();
+
+    Vector<int> candidates;
+    if (l == 0) {
+      candidates.resize(parameter_space.GetTotalNumberOfBasisFunctions());
+      std::iota(candidates.begin(), candidates.end(), 0);
+    } else {
+      // B-splines that are non-zero on children of refined elements
+      Array<int, para_dim> parent, element, function;
+      for (int const& refined : levels_[l - 1]->refined_elements_) {
+        int remainder{refined};
+        for (int i{}; i < para_dim; ++i) {
+          parent[i] = remainder % levels_[l - 1]->number_of_elements_[i];
+          remainder /= levels_[l - 1]->number_of_elements_[i];
+        }
+        for (int child{}; child < (1 << para_dim); ++child) {
+          Array<int, para_dim> first, last;
+          for (int i{}; i < para_dim; ++i) {
+            element[i] = 2 * parent[i] + ((child >> i) & 1);
+            last[i] = level.element_spans_[i][element[i]];
+            first[i] = last[i] - parameter_space.GetDegree(i);
+          }
+          function = first;
+          while (true) {
+            candidates.push_back(
+                DetermineFlatIndex(function, number_of_basis_functions));
+            int i{};
+            for (; i < para_dim; ++i) {
+              if (++function[i] <= last[i]) {
+                break;
+              }
+              function[i] = first[i];
+            }
+            if (i == para_dim) {
+              break;
+            }
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                       candidates.end());
+    }
+
+    for (int const& candidate : candidates) {
+      Box_ const& support = DetermineSupport(l, candidate);
+      if (AllOf(l, support, in_subdomain(l))
+          && !AllOf(l, support, [&](int const& element) {
+               return IsRefined(l, element);
+             })) {
+        basis_functions.emplace_back(l, candidate);
+      }
+    }
+  }
+
+  // truncation
+  Vector<Entries> entries(number_of_levels);
+  const int number_of_active_functions =
+      static_cast<int>(basis_functions.size());
+  for (int active{}; active < number_of_active_functions; ++active) {
+    auto const& [level, function] = basis_functions[active];
+    std::map<int, Type_> current{{function, Type_{1.0}}};
+    for (int m{level}; !current.empty(); ++m) {
+      std::map<int, Type_> next;
+      auto const number_of_basis_functions =
+          levels_[m]->parameter_space_->GetNumberOfBasisFunctions();
+      auto const number_of_fine_basis_functions =
+          (m + 1 < number_of_levels)
+              ? levels_[m + 1]->parameter_space_->GetNumberOfBasisFunctions()
+              : number_of_basis_functions;
+      for (auto const& [coarse, coefficient] : current) {
+        if (m + 1 == number_of_levels
+            || AllOf(m, DetermineSupport(m, coarse), not_refined(m))) {
+          entries[m][coarse].emplace_back(active, coefficient);
+          continue;
+        }
+
+        // tensor product of the children of each dimension
+        Array<int, para_dim> index, first, last, position;
+        int remainder{coarse};
+        for (int i{}; i < para_dim; ++i) {
+          index[i] = remainder % number_of_basis_functions[i];
+          remainder /= number_of_basis_functions[i];
+          SparseMatrix_ const& children = levels_[m]->children_[i];
+          first[i] = position[i] = children.row_offsets_[index[i]];
+          last[i] = children.row_offsets_[index[i] + 1];
+        }
+        while (true) {
+          Array<int, para_dim> child;
+          Type_ value{coefficient};
+          for (int i{}; i < para_dim; ++i) {
+            SparseMatrix_ const& children = levels_[m]->children_[i];
+            child[i] = children.column_indices_[position[i]];
+            value *= children.values_[position[i]];
+          }
+          int const& fine =
+              DetermineFlatIndex(child, number_of_fine_basis_functions);
+          if (!AllOf(m + 1,
+                     DetermineSupport(m + 1, fine),
+                     in_subdomain(m + 1))) {
+            next[fine] += value;
+          }
+          int i{};
+          for (; i < para_dim; ++i) {
+            if (++position[i] < last[i]) {
+              break;
+            }
+            position[i] = first[i];
+          }
+          if (i == para_dim) {
+            break;
+          }
+        }
+      }
+      current = std::move(next);
+    }
+  }
+
+  for (int m{}; m < number_of_levels; ++m) {
+    auto level = std::make_shared<Level_>(*levels_[m]);
+    level->represented_functions_.clear();
+    level->representation_ = SparseMatrix_{};
+    SparseMatrix_& representation = level->representation_;
+    representation.number_of_columns_ = number_of_active_functions;
+    for (auto const& [function, row] : entries[m]) {
+      level->represented_functions_.push_back(function);
+      for (auto const& [active, coefficient] : row) {
+        representation.column_indices_.push_back(active);
+        representation.values_.push_back(coefficient);
+      }
+      representation.row_offsets_.push_back(
+          representation.GetNumberOfNonZeros());
+    }
+    representation.number_of_rows_ =
+        static_cast<int>(level->represented_functions_.size());
+    levels_[m] = std::move(level);
+  }
+  basis_functions_ =
+      std::make_shared<BasisFunctions_ const>(std::move(basis_functions));
+}
+
+template<int para_dim>
+typename HierarchicalParameterSpace<para_dim>::Box_
+HierarchicalParameterSpace<para_dim>::DetermineSupport(
+    int const& level,
+    int const& function) const {
+  Level_ const& current_level = *levels_[level];
+  auto const number_of_basis_functions =
+      current_level.parameter_space_->GetNumberOfBasisFunctions();
+  Box_ support;
+  int remainder{function};
+  for (int i{}; i < para_dim; ++i) {
+    const int index = remainder % number_of_basis_functions[i];
+    remainder /= number_of_basis_functions[i];
+    support[i] = {current_level.support_begins_[i][index],
+                  current_level.support_ends_[i][index]};
+  }
+  return support;
+}
+
+template<int para_dim>
+template<typename LengthType>
+int HierarchicalParameterSpace<para_dim>::DetermineFlatIndex(
+    Array<int, para_dim> const& index,
+    Array<LengthType, para_dim> const& length) const {
+  LengthType flat_index{}, stride{1};
+  for (int i{}; i < para_dim; ++i) {
+    flat_index += index[i] * stride;
+    stride *= length[i];
+  }
+  return static_cast<int>(flat_index);
+}
+
+template<int para_dim>
+bool HierarchicalParameterSpace<para_dim>::IsRefined(
+    int const& level,
+    int const& element) const {
+  Elements_ const& refined_elements = levels_[level]->refined_elements_;
+  return std::binary_search(refined_elements.begin(),
+                            refined_elements.end(),
+                            element);
+}
+
+template<int para_dim>
+bool HierarchicalParameterSpace<para_dim>::IsInSubdomain(
+    int const& level,
+    int const& element) const {
+  if (level == 0) {
+    return true;
+  }
+  NumberOfElements_ const &number_of_elements =
+                              levels_[level]->number_of_elements_,
+                          &number_of_parent_elements =
+                              levels_[level - 1]->number_of_elements_;
+  Array<int, para_dim> parent;
+  int remainder{element};
+  for (int i{}; i < para_dim; ++i) {
+    parent[i] = (remainder % number_of_elements[i]) / 2;
+    remainder /= number_of_elements[i];
+  }
+  return IsRefined(level - 1,
+                   DetermineFlatIndex(parent, number_of_parent_elements));
+}
+
+template<int para_dim>
+template<typename Predicate>
+bool HierarchicalParameterSpace<para_dim>::AllOf(
+    int const& level,
+    Box_ const& box,
+    Predicate const& predicate) const {
+  NumberOfElements_ const& number_of_elements =
+      levels_[level]->number_of_elements_;
+  Array<int, para_dim> element;
+  for (int i{}; i < para_dim; ++i) {
+    if (box[i][0] == box[i][1]) {
+      return true;
+    }
+    element[i] = box[i][0];
+  }
+  while (true) {
+    if (!predicate(DetermineFlatIndex(element, number_of_elements))) {
+      return false;
+    }
+    int i{};
+    for (; i < para_dim; ++i) {
+      if (++element[i] < box[i][1]) {
+        break;
+      }
+      element[i] = box[i][0];
+    }
+    if (i == para_dim) {
+      return true;
+    }
+  }
+}
+
+// Sums the contributions of the B-splines of all levels that are non-zero at
+// the parametric coordinate.
+template<int para_dim>
+template<typename EvaluatePerDimension>
+typename HierarchicalParameterSpace<para_dim>::BasisValues_
+HierarchicalParameterSpace<para_dim>::CombineLevels(
+    const Type_* parametric_coordinate,
+    EvaluatePerDimension const& evaluate_per_dimension,
+    Tolerance const& tolerance) const {
+  Vector<std::pair<int, Type_>> contributions;
+  for (SharedPointer<Level_ const> const& level_pointer : levels_) {
+    Level_ const& level = *level_pointer;
+    Vector<int> const& represented_functions = level.represented_functions_;
+    if (represented_functions.empty()) {
+      continue;
+    }
+    ParameterSpace_ const& parameter_space = *level.parameter_space_;
+    SparseMatrix_ const& representation = level.representation_;
+    auto const number_of_basis_functions =
+        parameter_space.GetNumberOfBasisFunctions();
+    auto const& basis_values_per_dimension =
+        evaluate_per_dimension(parameter_space);
+    auto const first = parameter_space
+                           .FindFirstNonZeroBasisFunction(
+                               parametric_coordinate,
+                               tolerance)
+                           .GetIndex();
+
+    Array<int, para_dim> local{}, function;
+    while (true) {
+      Type_ value{1.0};
+      for (int i{}; i < para_dim; ++i) {
+        function[i] = first[i] + local[i];
+        value *= basis_values_per_dimension[i][local[i]];
+      }
+      auto const represented =
+          std::lower_bound(represented_functions.begin(),
+                           represented_functions.end(),
+                           DetermineFlatIndex(function,
+                                              number_of_basis_functions));
+      if (represented != represented_functions.end()
+          && *represented
+                 == DetermineFlatIndex(function, number_of_basis_functions)) {
+        const int row =
+            static_cast<int>(represented - represented_functions.begin());
+        for (Index k{representation.row_offsets_[row]};
+             k < representation.row_offsets_[row + 1];
+             ++k) {
+          contributions.emplace_back(representation.column_indices_[k],
+                                     value * representation.values_[k]);
+        }
+      }
+      int i{};
+      for (; i < para_dim; ++i) {
+        if (++local[i] <= parameter_space.GetDegree(i)) {
+          break;
+        }
+        local[i] = 0;
+      }
+      if (i == para_dim) {
+        break;
+      }
+    }
+  }
+
+  std::sort(contributions.begin(),
+            contributions.end(),
+            [](auto const& lhs, auto const& rhs) {
+              return lhs.first < rhs.first;
+            });
+  BasisValues_ basis_values;
+  auto& [functions, values] = basis_values;
+  for (auto const& [function, value] : contributions) {
+    if (!functions.empty() && functions.back() == function) {
+      values.back() += value;
+    } else {
+      functions.push_back(function);
+      values.push_back(value);
+    }
+  }
+  return basis_values;
+}
+
+template<int para_dim>
+void HierarchicalParameterSpace<para_dim>::ThrowIfLevelIsInvalid(
+    int const& level) const {
+  if (level < 0 || level >= GetNumberOfLevels()) {
+    throw OutOfRange("HierarchicalParameterSpace - level "
+                     + std::to_string(level) + " does not exist, there are "
+                     + std::to_string(GetNumberOfLevels()) + " levels.");
+  }
+}
@@ -20,6 +20,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/ParameterSpaces/knot_vector.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <functional>
 #include <iterator>
 #include <utility>
@@ -37,7 +39,7 @@ using utilities::numeric_operations::ThrowIfToleranceIsNegative;
 #endif
 
 KnotVector::KnotVector(Knots_ knots, Tolerance const& tolerance)
-    : knots_(std::move(knots)) {
+    : knots_(std::make_shared<Knots_>(std::move(knots))) {
 #ifndef NDEBUG
   Message const kName{"bsplinelib::parameter_spaces::KnotVector::KnotVector"};
 
@@ -52,31 +54,101 @@ KnotVector::KnotVector(Knots_ knots, Tolerance const& tolerance)
 #endif
 }
 
+KnotVector::KnotVector(KnotVector const& other)
+    : knots_(other.view_ ? std::make_shared<Knots_>(
+                 other.view_,
+                 other.view_ + other.view_size_)
+                         : other.knots_),
+      revision_(other.revision_) {}
+
+KnotVector::KnotVector(KnotVector&& other) noexcept
+    : knots_(std::exchange(other.knots_, std::make_shared<Knots_>())),
+      view_(std::exchange(other.view_, nullptr)),
+      view_size_(std::exchange(other.view_size_, 0)),
+      revision_(std::exchange(other.revision_, DetermineNextRevision())) {
+  other.run_lengths_.Invalidate();
+}
+
+KnotVector& KnotVector::operator=(KnotVector const& rhs) {
+  knots_ = rhs.view_ ? std::make_shared<Knots_>(rhs.view_,
+                                                rhs.view_ + rhs.view_size_)
+                     : rhs.knots_;
+  view_ = nullptr;
+  view_size_ = 0;
+  revision_ = rhs.revision_;
+  run_lengths_.Invalidate();
+  return *this;
+}
+
+KnotVector& KnotVector::operator=(KnotVector&& rhs) noexcept {
+  if (this != &rhs) {
+    knots_ = std::exchange(rhs.knots_, std::make_shared<Knots_>());
+    view_ = std::exchange(rhs.view_, nullptr);
+    view_size_ = std::exchange(rhs.view_size_, 0);
+    revision_ = std::exchange(rhs.revision_, DetermineNextRevision());
+    run_lengths_.Invalidate();
+    rhs.run_lengths_.Invalidate();
+  }
+  return *this;
+}
+
+KnotVector KnotVector::MakeView(Knot_* knots,
+                                int const& number_of_knots,
+                                Tolerance const& tolerance) {
+  KnotVector knot_vector;
+  knot_vector.view_ = knots;
+  knot_vector.view_size_ = number_of_knots;
+#ifndef NDEBUG
+  Message const kName{"bsplinelib::parameter_spaces::KnotVector::MakeView"};
+
+  try {
+    ThrowIfToleranceIsNegative(tolerance);
+    knot_vector.ThrowIfTooSmallOrNotNonDecreasing(tolerance);
+  } catch (DomainError const& exception) {
+    Throw(exception, kName);
+  } catch (InvalidArgument const& exception) {
+    Throw(exception, kName);
+  }
+#endif
+  return knot_vector;
+}
+
 Knot const& KnotVector::operator[](int const& index) const {
-  return knots_[index];
+  return GetData()[index];
 }
 
-int KnotVector::GetSize() const { return knots_.size(); }
+int KnotVector::GetSize() const {
+  return view_ ? view_size_ : static_cast<int>(knots_->size());
+}
 
-Knot const& KnotVector::GetFront() const { return knots_[0]; }
+Knot const& KnotVector::GetFront() const { return GetData()[0]; }
 
-Knot const& KnotVector::GetBack() const { return knots_[knots_.size() - 1]; }
+Knot const& KnotVector::GetBack() const { return GetData()[GetSize() - 1]; }
+
+typename KnotVector::Knots_ const& KnotVector::GetKnots() const {
+  if (view_) {
+    throw RuntimeError("KnotVector::GetKnots - the knots are a view of the "
+                       "caller's knots, use GetKnotRange instead.");
+  }
+  return *knots_;
+}
 
 void KnotVector::UpdateKnot(const int id, Knot const& knot) {
   bool good{true};
+  Knot const* knots = GetData();
 
   // first knot checks lower bound
   if (id == 0) {
-    if (knots_[id + 1] < knot) {
+    if (knots[id + 1] < knot) {
       good = false;
     }
     // last knot checks upper bound
-  } else if (id == static_cast<int>(knots_.size() - 1)) {
-    if (knots_[id - 1] > knot) {
+  } else if (id == GetSize() - 1) {
+    if (knots[id - 1] > knot) {
       good = false;
     }
     // otherwise, both
-  } else if (knots_[id - 1] > knot || knots_[id + 1] < knot) {
+  } else if (knots[id - 1] > knot || knots[id + 1] < knot) {
     good = false;
   }
 
@@ -85,7 +157,9 @@ void KnotVector::UpdateKnot(const int id, Knot const& knot) {
         "KnotVector::UpdateKnot - updated knot must be non-decreasing.");
   }
 
-  knots_[id] = knot;
+  GetMutableData()[id] = knot;
+  run_lengths_.Invalidate();
+  revision_ = DetermineNextRevision();
 }
 
 void KnotVector::Scale(Knot const& min, Knot const& max) {
@@ -94,9 +168,12 @@ void KnotVector::Scale(Knot const& min, Knot const& max) {
   }
   const auto current_min = GetFront();
   const auto scale_factor = (max - min) / (GetBack() - current_min);
-  for (auto& knot : knots_) {
-    knot = ((knot - current_min) * scale_factor) + min;
+  Knot* knots = GetMutableData();
+  for (int i{}, size{GetSize()}; i < size; ++i) {
+    knots[i] = ((knots[i] - current_min) * scale_factor) + min;
   }
+  run_lengths_.Invalidate();
+  revision_ = DetermineNextRevision();
 }
 
 bool KnotVector::DoesParametricCoordinateEqualBack(
@@ -126,7 +203,7 @@ bool KnotVector::DoesParametricCoordinateEqualLastSupport(
   assert(tolerance);
 
   return std::abs(static_cast<Knot>(parametric_coordinate)
-                  - knots_[knots_.size() - 1 - degree])
+                  - GetData()[GetSize() - 1 - degree])
          < tolerance;
 }
 
@@ -168,7 +245,7 @@ KnotSpan KnotVector::FindSpan(Knot const& parametric_coordinate,
     Throw(exception, kName);
   }
 #endif
-  ConstIterator_ const &knots_begin = knots_.begin(), &knots_end = knots_.end();
+  Knot const *knots_begin = GetData(), *knots_end = knots_begin + GetSize();
 
   return KnotSpan{static_cast<int>(
       std::distance(
@@ -185,7 +262,7 @@ KnotSpan KnotVector::FindEffectiveSpan(Knot const& parametric_coordinate,
   assert(tolerance > 0.0);
   // TODO need out of scope check
 
-  ConstIterator_ const &knots_begin = knots_.begin(), &knots_end = knots_.end();
+  Knot const *knots_begin = GetData(), *knots_end = knots_begin + GetSize();
 
   return KnotSpan{static_cast<int>(
       std::distance(
@@ -214,21 +291,10 @@ KnotVector::DetermineMultiplicity(Knot const& parametric_coordinate,
     Throw(exception, kName);
   }
 #endif
-  auto knot_iter = knots_.cbegin();
-
-  // initialize multiplicity and loop around
-  int multiplicity{};
-  for (; knot_iter != knots_.cend();) {
-    if (std::abs(parametric_coordinate - *knot_iter++) < tolerance) {
-      ++multiplicity;
-      while (std::abs(parametric_coordinate - *knot_iter++) < tolerance) {
-        ++multiplicity;
-      }
-      break;
-    }
-  }
-
-  return Multiplicity{multiplicity};
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  UpdateRunLengths(tolerance);
+  int const& run = FindRun(parametric_coordinate, tolerance);
+  return Multiplicity{run < 0 ? 0 : run_lengths_.multiplicities_[run]};
 }
 
 Vector<int> KnotVector::DetermineMultiplicities(const Knot_* knot_vector_data,
@@ -241,7 +307,7 @@ Vector<int> KnotVector::DetermineMultiplicities(const Knot_* knot_vector_data,
   multiplicities.reserve(knot_vector_size);
 
   // initialize unique_knot - alternative is to have an iterator
-  double unique_knot{knot_vector_data[0]};
+  Knot_ unique_knot{knot_vector_data[0]};
   int multiplicity{};
 
   // again, assumed sorted kv
@@ -266,6 +332,13 @@ Vector<int> KnotVector::DetermineMultiplicities(const Knot_* knot_vector_data,
   return multiplicities;
 }
 
+Vector<int>
+KnotVector::DetermineMultiplicities(Tolerance const& tolerance) const {
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  UpdateRunLengths(tolerance);
+  return run_lengths_.multiplicities_;
+}
+
 KnotVector::Knots_
 KnotVector::GetUniqueKnots(Tolerance const& tolerance) const {
 #ifndef NDEBUG
@@ -276,14 +349,79 @@ KnotVector::GetUniqueKnots(Tolerance const& tolerance) const {
           "bsplinelib::parameter_spaces::KnotVector::GetUniqueKnots");
   }
 #endif
-  Knots_ unique_knots;
-  std::unique_copy(knots_.begin(),
-                   knots_.end(),
-                   std::back_inserter(unique_knots),
-                   [&](Knot const& lhs_knot, Knot const& rhs_knot) {
-                     return std::abs(lhs_knot - rhs_knot) < tolerance;
-                   });
-  return unique_knots;
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  UpdateRunLengths(tolerance);
+  return run_lengths_.unique_knots_;
+}
+
+KnotVector KnotVector::DetermineUnion(
+    Vector<SharedPointer<KnotVector>> const& knot_vectors,
+    Tolerance const& tolerance) {
+  if (knot_vectors.empty()) {
+    return KnotVector{};
+  }
+
+  // (unique knot, multiplicity) of all knot vectors sorted by knot
+  Vector<std::pair<Knot, int>> runs;
+  KnotVector const& first = *knot_vectors.front();
+  for (SharedPointer<KnotVector> const& knot_vector : knot_vectors) {
+    if (std::abs(knot_vector->GetFront() - first.GetFront()) > tolerance
+        || std::abs(knot_vector->GetBack() - first.GetBack()) > tolerance) {
+      throw DomainError("KnotVector::DetermineUnion - knot vectors have to "
+                        "share front and back knots.");
+    }
+    std::lock_guard<std::mutex> lock(knot_vector->run_lengths_.mutex_);
+    knot_vector->UpdateRunLengths(tolerance);
+    RunLengths_ const& run_lengths = knot_vector->run_lengths_;
+    for (std::size_t i{}; i < run_lengths.unique_knots_.size(); ++i) {
+      runs.emplace_back(run_lengths.unique_knots_[i],
+                        run_lengths.multiplicities_[i]);
+    }
+  }
+  std::sort(runs.begin(), runs.end());
+
+  Knots_ knots;
+  for (auto run = runs.begin(); run != runs.end();) {
+    auto const& [knot, multiplicity] = *run;
+    int maximum_multiplicity{multiplicity};
+    auto next = std::next(run);
+    for (; next != runs.end() && next->first - knot <= tolerance; ++next) {
+      maximum_multiplicity = std::max(maximum_multiplicity, next->second);
+    }
+    knots.insert(knots.end(), maximum_multiplicity, knot);
+    run = next;
+  }
+  return KnotVector{std::move(knots), tolerance};
+}
+
+KnotVector::Knots_
+KnotVector::DetermineMissingKnots(KnotVector const& superset,
+                                  Tolerance const& tolerance) const {
+  Knots_ const& knots = GetUniqueKnots(tolerance);
+  Vector<int> const& multiplicities = DetermineMultiplicities(tolerance);
+
+  Knots_ missing_knots;
+  std::size_t i{};
+  std::lock_guard<std::mutex> lock(superset.run_lengths_.mutex_);
+  superset.UpdateRunLengths(tolerance);
+  RunLengths_ const& run_lengths = superset.run_lengths_;
+  for (std::size_t j{}; j < run_lengths.unique_knots_.size(); ++j) {
+    Knot const& knot = run_lengths.unique_knots_[j];
+    int number_of_missing_knots{run_lengths.multiplicities_[j]};
+    if (i < knots.size() && std::abs(knots[i] - knot) <= tolerance) {
+      number_of_missing_knots -= multiplicities[i++];
+    }
+    if (number_of_missing_knots < 0 || (i < knots.size() && knots[i] < knot)) {
+      throw DomainError("KnotVector::DetermineMissingKnots - knot vector is "
+                        "not contained in the superset.");
+    }
+    missing_knots.insert(missing_knots.end(), number_of_missing_knots, knot);
+  }
+  if (i != knots.size()) {
+    throw DomainError("KnotVector::DetermineMissingKnots - knot vector is not "
+                      "contained in the superset.");
+  }
+  return missing_knots;
 }
 
 void KnotVector::Insert(Knot knot,
@@ -305,9 +443,31 @@ void KnotVector::Insert(Knot knot,
     Throw(exception, kName);
   }
 #endif
-  knots_.insert(knots_.begin() + FindSpan(knot, tolerance).Get() + 1,
+  MakeKnotsUnique();
+  knots_->insert(knots_->begin() + FindSpan(knot, tolerance).Get() + 1,
                 multiplicity,
-                std::move(knot));
+                knot);
+  revision_ = DetermineNextRevision();
+
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  if (!run_lengths_.is_valid_ || run_lengths_.tolerance_ != tolerance) {
+    run_lengths_.is_valid_ = false;
+    return;
+  }
+  Knots_& unique_knots = run_lengths_.unique_knots_;
+  Vector<int>& multiplicities = run_lengths_.multiplicities_;
+  if (int const& run = FindRun(knot, tolerance); run < 0) {
+    int const& new_run = static_cast<int>(
+        std::distance(unique_knots.begin(),
+                      std::upper_bound(unique_knots.begin(),
+                                       unique_knots.end(),
+                                       knot)));
+    unique_knots.insert(unique_knots.begin() + new_run, knot);
+    multiplicities.insert(multiplicities.begin() + new_run, multiplicity);
+  } else {
+    unique_knots[run] = std::min(unique_knots[run], knot);
+    multiplicities[run] += multiplicity;
+  }
 }
 
 Multiplicity KnotVector::Remove(Knot const& knot,
@@ -328,13 +488,27 @@ Multiplicity KnotVector::Remove(Knot const& knot,
   if (Multiplicity const number_of_removals{
           std::min(multiplicity, DetermineMultiplicity(knot, tolerance))};
       number_of_removals != 0) {
+    MakeKnotsUnique();
     KnotSpan const& knot_span = FindSpan(knot, tolerance);
     if (DoesParametricCoordinateEqualBack(knot, tolerance)) {
-      ConstIterator_ const& end = knots_.end();
-      knots_.erase(end - number_of_removals, end);
+      ConstIterator_ const& end = knots_->end();
+      knots_->erase(end - number_of_removals, end);
     } else {
-      ConstIterator_ const& first_knot = (knots_.begin() + knot_span.Get());
-      knots_.erase(first_knot - (number_of_removals - 1), first_knot + 1);
+      ConstIterator_ const& first_knot = (knots_->begin() + knot_span.Get());
+      knots_->erase(first_knot - (number_of_removals - 1), first_knot + 1);
+    }
+    revision_ = DetermineNextRevision();
+
+    std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+    if (!run_lengths_.is_valid_ || run_lengths_.tolerance_ != tolerance) {
+      run_lengths_.is_valid_ = false;
+    } else if (int const& run = FindRun(knot, tolerance);
+               (run_lengths_.multiplicities_[run] -= number_of_removals)
+               == 0) {
+      run_lengths_.unique_knots_.erase(run_lengths_.unique_knots_.begin()
+                                       + run);
+      run_lengths_.multiplicities_.erase(run_lengths_.multiplicities_.begin()
+                                         + run);
     }
     return number_of_removals;
   } else {
@@ -342,23 +516,74 @@ Multiplicity KnotVector::Remove(Knot const& knot,
   }
 }
 
+// Rebuilds the knots run by run at once instead of inserting each unique knot
+// separately.
 void KnotVector::IncreaseMultiplicities(Multiplicity const& multiplicity,
                                         Tolerance const& tolerance) {
-  for (Knot const& knot : GetUniqueKnots(tolerance))
-    Insert(knot, multiplicity, tolerance);
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  UpdateRunLengths(tolerance);
+  Knots_ const& unique_knots = run_lengths_.unique_knots_;
+  Vector<int>& multiplicities = run_lengths_.multiplicities_;
+  int const& number_of_runs = unique_knots.size();
+
+  Knots_ knots;
+  knots.reserve(GetSize() + number_of_runs * multiplicity);
+  Knot const* first_knot{GetData()};
+  for (int run{}; run < number_of_runs; ++run) {
+    Knot const* last_knot{first_knot + multiplicities[run]};
+    knots.insert(knots.end(), first_knot, last_knot);
+    knots.insert(knots.end(), multiplicity, unique_knots[run]);
+    multiplicities[run] += multiplicity;
+    first_knot = last_knot;
+  }
+  knots_ = std::make_shared<Knots_>(std::move(knots));
+  view_ = nullptr;
+  view_size_ = 0;
+  revision_ = DetermineNextRevision();
 }
 
+// Keeps the first s-r knots of each run, i.e., runs of multiplicity s <= r
+// are removed.
 void KnotVector::DecreaseMultiplicities(Multiplicity const& multiplicity,
                                         Tolerance const& tolerance) {
-  if (GetSize() > 2)
-    for (Knot const& knot : GetUniqueKnots(tolerance))
-      Remove(knot, multiplicity, tolerance);
+  if (GetSize() <= 2) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(run_lengths_.mutex_);
+  UpdateRunLengths(tolerance);
+  int const& number_of_runs = run_lengths_.unique_knots_.size();
+
+  Knots_ knots, unique_knots;
+  Vector<int> multiplicities;
+  knots.reserve(GetSize());
+  Knot const* first_knot{GetData()};
+  for (int run{}; run < number_of_runs; ++run) {
+    int const& run_length = run_lengths_.multiplicities_[run];
+    if (int const remaining = run_length - multiplicity; remaining > 0) {
+      knots.insert(knots.end(), first_knot, first_knot + remaining);
+      unique_knots.push_back(run_lengths_.unique_knots_[run]);
+      multiplicities.push_back(remaining);
+    }
+    first_knot += run_length;
+  }
+  knots_ = std::make_shared<Knots_>(std::move(knots));
+  view_ = nullptr;
+  view_size_ = 0;
+  revision_ = DetermineNextRevision();
+  run_lengths_.unique_knots_ = std::move(unique_knots);
+  run_lengths_.multiplicities_ = std::move(multiplicities);
 }
 
 typename KnotVector::OutputInformation_
 KnotVector::Write(Precision const& precision) const {
-  return utilities::string_operations::Write<OutputInformation_>(knots_,
-                                                                 precision);
+  using utilities::string_operations::Write;
+
+  if (view_) {
+    return Write<OutputInformation_>(Knots_(view_, view_ + view_size_),
+                                     precision);
+  }
+  return Write<OutputInformation_>(*knots_, precision);
 }
 
 std::string KnotVector::StringRepresentation() const {
@@ -366,13 +591,12 @@ std::string KnotVector::StringRepresentation() const {
   const int size = GetSize();
   // reserve enough space
   s.reserve(size * 3 + 20);
-  int i{}, j{size - 1};
-  for (const auto& k : knots_) {
-    s.append(std::to_string(k));
-    if (i != j) {
+  Knot const* knots = GetData();
+  for (int i{}; i < size; ++i) {
+    s.append(std::to_string(knots[i]));
+    if (i != size - 1) {
       s.append(", ");
     }
-    ++i;
   }
   s.append("]");
 
@@ -394,16 +618,80 @@ void KnotVector::ThrowIfParametricCoordinateIsOutsideScope(
 }
 #endif
 
+void KnotVector::MakeKnotsUnique() {
+  if (view_) {
+    knots_ = std::make_shared<Knots_>(view_, view_ + view_size_);
+    view_ = nullptr;
+    view_size_ = 0;
+  } else if (knots_.use_count() > 1) {
+    knots_ = std::make_shared<Knots_>(*knots_);
+  } else {
+    // use_count is a relaxed load, i.e., synchronizes with the release of the
+    // last other owner (e.g., a reader on another thread) only via this fence
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+}
+
+KnotVector::Knot_* KnotVector::GetMutableData() {
+  if (view_) {
+    return view_;
+  }
+  MakeKnotsUnique();
+  return knots_->data();
+}
+
+typename KnotVector::Revision_ KnotVector::DetermineNextRevision() {
+  static std::atomic<Revision_> next_revision{};
+  return next_revision.fetch_add(1, std::memory_order_relaxed);
+}
+
+void KnotVector::UpdateRunLengths(Tolerance const& tolerance) const {
+  if (run_lengths_.is_valid_ && run_lengths_.tolerance_ == tolerance) {
+    return;
+  }
+
+  Knots_& unique_knots = run_lengths_.unique_knots_;
+  Vector<int>& multiplicities = run_lengths_.multiplicities_;
+  unique_knots.clear();
+  multiplicities.clear();
+  if (GetSize() > 0) {
+    Knot const* knots = GetData();
+    multiplicities = DetermineMultiplicities(knots, GetSize(), tolerance);
+    unique_knots.reserve(multiplicities.size());
+    int first_knot{};
+    for (int const& multiplicity : multiplicities) {
+      unique_knots.push_back(knots[first_knot]);
+      first_knot += multiplicity;
+    }
+  }
+  run_lengths_.tolerance_ = tolerance;
+  run_lengths_.is_valid_ = true;
+}
+
+// Returns the first run whose unique knot is within tolerance of given knot or
+// -1 if there is none.
+int KnotVector::FindRun(Knot const& knot, Tolerance const& tolerance) const {
+  Knots_ const& unique_knots = run_lengths_.unique_knots_;
+  ConstIterator_ const& run = std::upper_bound(unique_knots.begin(),
+                                               unique_knots.end(),
+                                               knot - tolerance);
+  if (run == unique_knots.end() || !(std::abs(*run - knot) < tolerance)) {
+    return -1;
+  }
+  return static_cast<int>(std::distance(unique_knots.begin(), run));
+}
+
 void KnotVector::ThrowIfTooSmallOrNotNonDecreasing(
     Tolerance const& tolerance) const {
-  int const& number_of_knots = knots_.size();
+  int const& number_of_knots = GetSize();
+  Knot const* knots = GetData();
   if (number_of_knots < 2)
     throw DomainError(
         "The knot vector has to contain at least 2 knots but only contains "
         + to_string(number_of_knots) + ".");
 
   for (int i{1}; i < number_of_knots; ++i) {
-    Knot const &current_knot = knots_[i], &previous_knot = knots_[i - 1];
+    Knot const &current_knot = knots[i], &previous_knot = knots[i - 1];
 
     if ((current_knot + tolerance) < previous_knot)
       throw DomainError("The knot vector has to be a non-decreasing sequence "
@@ -20,6 +20,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #ifndef SOURCES_PARAMETERSPACES_KNOT_VECTOR_HPP_
 #define SOURCES_PARAMETERSPACES_KNOT_VECTOR_HPP_
 
+#include <cstdint>
+#include <mutex>
+
 #include "BSplineLib/Utilities/containers.hpp"
 #include "BSplineLib/Utilities/named_type.hpp"
 #include "BSplineLib/Utilities/string_operations.hpp"
@@ -27,6 +30,28 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 namespace bsplinelib::parameter_spaces {
 
 // KnotVectors are sequences of non-decreasing real numbers (called knots).
+// Unique knots and their multiplicities are cached for the last used
+// tolerance and updated by Insert and Remove.  Other modifications (e.g.,
+// UpdateKnot, Scale) invalidate the cache.  The knots are only modified
+// through the member functions, i.e., GetKnots is read-only.  Copies share
+// the knots until either of them is modified (copy-on-write).  Each state of
+// the knots has a revision (GetRevision) that is unique among all knot
+// vectors, e.g., to tell whether data derived from the knots is out of date.
+//
+// KnotVectors can also view knots owned by the caller (e.g., a NumPy array or
+// shared memory) instead of copying them.  The caller keeps ownership, i.e.,
+// the knots have to outlive the knot vector and must not be modified by the
+// caller while it is in use.  Views are read through GetData and GetSize or
+// GetKnotRange, GetKnots is not available for them.  UpdateKnot and
+// Scale write through to the caller's knots.
+// Operations that change the number of knots (Insert, Remove,
+// IncreaseMultiplicities, DecreaseMultiplicities) adopt a copy first, after
+// which the caller's knots are no longer referenced.
+// Copies of views own a copy of the knots.
+//
+// Example (view):
+//   SharedPointer<KnotVector> const knot_vector = std::make_shared<KnotVector>(
+//       KnotVector::MakeView(knots, number_of_knots));
 //
 // Example:
 //   using Knot = KnotVector::Knot_;
@@ -46,28 +71,76 @@ namespace bsplinelib::parameter_spaces {
 //   Evaluates to true as 1.0 is the last knot.
 class KnotVector {
 public:
-  // using Knot_ = ParametricCoordinate;
-  using Knot_ = double;
+  using Knot_ = ParametricCoordinate;
   using OutputInformation_ = StringVector;
   using Knots_ = Vector<Knot_>;
   // using Type_ = Knot_::Type_;
   using Type_ = Knot_;
+  using Revision_ = std::uint64_t;
+
+  // Read-only range of contiguous knots, valid until the knots are modified.
+  class ConstKnots_ {
+  public:
+    ConstKnots_(Knot_ const* data, int const& size)
+        : data_{data},
+          size_{size} {}
+
+    Knot_ const* begin() const { return data_; }
+    Knot_ const* end() const { return data_ + size_; }
+    Knot_ const* data() const { return data_; }
+    int const& size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    Knot_ const& operator[](int const& index) const { return data_[index]; }
+
+  private:
+    Knot_ const* data_;
+    int size_;
+  };
 
   KnotVector() = default;
   explicit KnotVector(Knots_ knots, Tolerance const& tolerance = kEpsilon);
-  KnotVector(KnotVector const& other) = default;
-  KnotVector(KnotVector&& other) noexcept = default;
-  KnotVector& operator=(KnotVector const& rhs) = default;
-  KnotVector& operator=(KnotVector&& rhs) noexcept = default;
+  KnotVector(KnotVector const& other);
+  // Moved-from knot vectors own empty knots.
+  KnotVector(KnotVector&& other) noexcept;
+  KnotVector& operator=(KnotVector const& rhs);
+  KnotVector& operator=(KnotVector&& rhs) noexcept;
   virtual ~KnotVector() = default;
 
+  /// @brief Knot vector viewing the caller's knots without copying them (see
+  /// above).  A named function rather than a constructor, as knot vectors are
+  /// frequently initialized from braced lists starting with the literal 0.
+  /// @param knots
+  /// @param number_of_knots
+  /// @param tolerance
+  /// @return
+  static KnotVector MakeView(Knot_* knots,
+                             int const& number_of_knots,
+                             Tolerance const& tolerance = kEpsilon);
+
   virtual Knot_ const& operator[](int const& index) const;
 
   virtual int GetSize() const;
   virtual Knot_ const& GetFront() const;
   virtual Knot_ const& GetBack() const;
-  virtual Knots_ const& GetKnots() const { return knots_; }
-  virtual Knots_& GetKnots() { return knots_; }
+  // Throws for views, use GetKnotRange instead.
+  virtual Knots_ const& GetKnots() const;
+  /// @brief Knots as read-only range, also of views.
+  /// @return
+  virtual ConstKnots_ GetKnotRange() const { return {GetData(), GetSize()}; }
+  /// @brief Contiguous knots, also of views.
+  /// @return
+  virtual Knot_ const* GetData() const {
+    return view_ ? view_ : knots_->data();
+  }
+  /// @brief false for views of the caller's knots
+  /// @return
+  bool OwnsData() const { return view_ == nullptr; }
+
+  /// @brief Revision of the knots.  It changes whenever they are modified.
+  /// Copies start with the revision of the original.  Modifications of the
+  /// caller's knots viewed by the knot vector are not tracked.
+  /// @return
+  Revision_ const& GetRevision() const { return revision_; }
 
   /// inplace update. validates before
   virtual void UpdateKnot(const int id, Knot_ const& knot);
@@ -125,15 +198,31 @@ public:
   /// @param tolerance
   /// @return
   virtual Vector<int>
-  DetermineMultiplicities(Tolerance const& tolerance = kEpsilon) const {
-    return DetermineMultiplicities(knots_.data(), knots_.size(), tolerance);
-  };
+  DetermineMultiplicities(Tolerance const& tolerance = kEpsilon) const;
 
   /// @brief returns copy of unique knots
   /// @param tolerance
   /// @return
   virtual Knots_ GetUniqueKnots(Tolerance const& tolerance = kEpsilon) const;
 
+  /// @brief Union of knot vectors, i.e., each unique knot with the maximum of
+  /// its multiplicities. Knot vectors have to share front and back knots.
+  /// @param knot_vectors
+  /// @param tolerance
+  /// @return
+  static KnotVector
+  DetermineUnion(Vector<SharedPointer<KnotVector>> const& knot_vectors,
+                 Tolerance const& tolerance = kEpsilon);
+
+  /// @brief Knots (repeated according to multiplicity) that have to be
+  /// inserted into this knot vector to obtain the superset.
+  /// @param superset has to contain all knots of this knot vector
+  /// @param tolerance
+  /// @return
+  virtual Knots_ DetermineMissingKnots(KnotVector const& superset,
+                                       Tolerance const& tolerance = kEpsilon)
+      const;
+
   virtual void Insert(Knot_ knot,
                       Multiplicity const& multiplicity = kMultiplicity,
                       Tolerance const& tolerance = kEpsilon);
@@ -164,10 +253,59 @@ public:
       Tolerance const& tolerance = kEpsilon) const;
 
 protected:
-  Knots_ knots_;
+  // Shared with copies until modified.  Unused by views.
+  SharedPointer<Knots_> knots_{std::make_shared<Knots_>()};
+  // Caller's knots if this is a view.
+  Knot_* view_{};
+  int view_size_{};
+  Revision_ revision_{DetermineNextRevision()};
+
+  // Clones the knots if they are shared with copies and adopts a copy of the
+  // caller's knots if this is a view.
+  void MakeKnotsUnique();
 
 private:
   using ConstIterator_ = typename Knots_::const_iterator;
+
+  // Writable knots, i.e., the caller's knots for views.
+  Knot_* GetMutableData();
+  // Unique among all knot vectors and thread-safe.
+  static Revision_ DetermineNextRevision();
+
+  // Run-length representation of the knots, i.e., unique knots (first knot
+  // of each run) and their multiplicities for a given tolerance.  Copies
+  // start out invalid, as copying the mutex is neither possible nor needed.
+  struct RunLengths_ {
+    RunLengths_() = default;
+    RunLengths_(RunLengths_ const&) {}
+    RunLengths_(RunLengths_&&) noexcept {}
+    RunLengths_& operator=(RunLengths_ const&) {
+      Invalidate();
+      return *this;
+    }
+    RunLengths_& operator=(RunLengths_&&) noexcept {
+      Invalidate();
+      return *this;
+    }
+    ~RunLengths_() = default;
+
+    void Invalidate() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_valid_ = false;
+    }
+
+    std::mutex mutex_;
+    bool is_valid_{false};
+    Tolerance tolerance_{};
+    Knots_ unique_knots_;
+    Vector<int> multiplicities_;
+  };
+
+  // Both require run_lengths_.mutex_ to be locked by the caller.
+  void UpdateRunLengths(Tolerance const& tolerance) const;
+  int FindRun(Knot_ const& knot, Tolerance const& tolerance) const;
+
+  mutable RunLengths_ run_lengths_;
 };
 
 template<int para_dim>
@@ -21,8 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #define SOURCES_PARAMETERSPACES_PARAMETER_SPACE_HPP_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <numeric>
 #include <utility>
 
@@ -33,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Utilities/math_operations.hpp"
 #include "BSplineLib/Utilities/named_type.hpp"
 #include "BSplineLib/Utilities/numeric_operations.hpp"
+#include "BSplineLib/Utilities/strided_index.hpp"
 #include "BSplineLib/Utilities/string_operations.hpp"
 
 namespace bsplinelib::parameter_spaces {
@@ -69,6 +72,19 @@ public:
   virtual const SharedPointer<KnotVector>* KnotVectorsEnd() const = 0;
 };
 
+/// @brief Refinement of a single parametric dimension. The degree is elevated
+/// to degree_ (negative values keep the degree) and knots_ are inserted either
+/// before (h- before p-refinement) or after the elevation (k-refinement).
+/// Repeated knots are inserted repeatedly.
+struct Refinement {
+  Degree degree_{-1};
+  KnotVector::Knots_ knots_;
+  bool insert_knots_first_{false};
+};
+
+template<int para_dim>
+using RefinementPlan = Array<Refinement, para_dim>;
+
 /// @brief ParameterSpaces provide the B-spline basis functions corresponding to
 /// given knot vectors and degrees.
 /// @tparam para_dim
@@ -84,8 +100,9 @@ public:
   using Degrees_ = Array<Degree, para_dim>;
   using Derivative_ = Array<Derivative, para_dim>;
   using ElevationCoefficients_ = Vector<BinomialRatios_>;
-  using ElevationInformation_ = Tuple<Index, ElevationCoefficients_>;
+  using ElevationInformation_ = Tuple<Degree, ElevationCoefficients_>;
   using Index_ = utilities::Index<para_dim>;
+  using StridedIndex_ = utilities::StridedIndex<para_dim>;
   using IndexLength_ = typename Index_::Length_;
   using IndexValue_ = typename Index_::Value_;
   using KnotRatios_ = Vector<KnotRatio>;
@@ -103,6 +120,9 @@ public:
   using BezierInformation_ = Tuple<int, Knots_>;
   using Knot_ = typename Knots_::value_type;
   using KnotSpans_ = Array<KnotSpan, para_dim>;
+  // Parametric coordinates in evaluation order and, in the same order, their
+  // effective knot spans.
+  using EvaluationOrder_ = Tuple<Vector<Index>, Vector<KnotSpans_>>;
 
   // for evaluated basis values
   template<typename T>
@@ -117,6 +137,22 @@ public:
   using BasisValueType_ = typename BasisValues_::value_type;
   using BasisValuesPerDimension_ = Array<BasisValues_, para_dim>;
 
+  // Bezier extraction operators of all elements of one dimension, stored
+  // contiguously with shape (number of elements, p+1, p+1).
+  using BezierExtractionOperators_ =
+      bsplinelib::utilities::containers::Data<Type_, 3>;
+  using ElementSpans_ = Vector<int>;
+  using BezierExtractionInformation_ =
+      Tuple<ElementSpans_, BezierExtractionOperators_>;
+  // Tensor product of the operators of each dimension for a single element.
+  using BezierExtractionOperator_ =
+      bsplinelib::utilities::containers::Data<Type_, 2>;
+  using SparseMatrix_ =
+      bsplinelib::utilities::containers::CompressedSparseRowMatrix<Type_>;
+  using ProlongationFactors_ = Array<SparseMatrix_, para_dim>;
+  using Refinement_ = Refinement;
+  using RefinementPlan_ = RefinementPlan<para_dim>;
+
   ParameterSpace() = default;
   ParameterSpace(KnotVectors_ knot_vectors, Degrees_ degrees)
       : knot_vectors_(std::move(knot_vectors)),
@@ -154,7 +190,7 @@ public:
   virtual Index_ Behind() const;
 
   virtual NumberOfBasisFunctions_ GetNumberOfBasisFunctions() const;
-  virtual int GetTotalNumberOfBasisFunctions() const;
+  virtual Index GetTotalNumberOfBasisFunctions() const;
   // Number of non-zero basis functions is equal to p+1 - see NURBS book P2.2.
   NumberOfBasisFunctions_ GetNumberOfNonZeroBasisFunctions() const;
 
@@ -164,13 +200,115 @@ public:
   virtual Index_
   FindFirstNonZeroBasisFunction(const Type_* parametric_coordinate,
                                 Tolerance const& tolerance = kEpsilon) const;
+  /// @brief Strided index over the non-zero basis functions at the parametric
+  /// coordinate, whose one-dimensional index refers to all basis functions.
+  StridedIndex_
+  FindNonZeroBasisFunctions(const Type_* parametric_coordinate,
+                            Tolerance const& tolerance = kEpsilon) const;
 
   virtual KnotSpans_ FindKnotSpans(const Type_* parametric_coordinate,
                                    Tolerance const& tolerance = kEpsilon) const;
+  /// @brief Knot spans the basis functions are evaluated on, i.e., the first
+  /// non-zero basis function of dimension i is span_i - p_i.
+  /// @param parametric_coordinate
+  /// @param tolerance
+  /// @return
+  virtual KnotSpans_
+  FindEffectiveKnotSpans(const Type_* parametric_coordinate,
+                         Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Orders parametric coordinates by their elements along a Morton
+  /// (Z-order) curve, i.e., coordinates evaluated one after another mostly
+  /// share knot spans and control points.  Coordinates of the same element
+  /// keep their relative order.  Sorts serially.
+  /// @param parametric_coordinates (number_of_parametric_coordinates x
+  /// para_dim) array
+  /// @param number_of_parametric_coordinates
+  /// @param tolerance
+  /// @return indices of the coordinates in evaluation order and their
+  /// effective knot spans
+  virtual EvaluationOrder_
+  DetermineEvaluationOrder(const Type_* parametric_coordinates,
+                           Index const& number_of_parametric_coordinates,
+                           Tolerance const& tolerance = kEpsilon) const;
   virtual BezierInformation_
   DetermineBezierExtractionKnots(Dimension const& dimension,
                                  Tolerance const& tolerance = kEpsilon) const;
 
+  /// @brief Knot spans of non-zero length within the support of the basis,
+  /// i.e., elements, of given dimension.
+  /// @param dimension
+  /// @param tolerance
+  /// @return
+  virtual ElementSpans_
+  DetermineElementSpans(Dimension const& dimension,
+                        Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Computes Bezier extraction operators C_e of all elements of given
+  /// dimension, such that the p+1 basis functions that do not vanish on
+  /// element e satisfy N_{span-p+a} = sum_b C_e(a, b) B_b, where B_b are the
+  /// Bernstein polynomials of the element. Entries are obtained by blossoming,
+  /// so unclamped knot vectors are supported as well.
+  /// @param dimension
+  /// @param tolerance
+  /// @return element spans and operators
+  virtual BezierExtractionInformation_
+  DetermineBezierExtractionOperators(
+      Dimension const& dimension,
+      Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Cached version of DetermineBezierExtractionOperators. Operators
+  /// are recomputed once knots or degree of the dimension change. Thread-safe.
+  /// @param dimension
+  /// @param tolerance
+  /// @return element spans and operators
+  virtual SharedPointer<BezierExtractionInformation_ const>
+  GetBezierExtractionOperators(Dimension const& dimension,
+                               Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Bezier extraction operator of an element of the tensor product
+  /// basis, i.e., C_e = C_e^0 x ... x C_e^{para_dim-1}. Elements as well as
+  /// local basis functions (rows) and Bernstein polynomials (columns) are
+  /// ordered with the first dimension running fastest.
+  /// @param element
+  /// @param tolerance
+  /// @return operator with shape (prod(p_i + 1), prod(p_i + 1))
+  virtual BezierExtractionOperator_
+  DetermineBezierExtractionOperator(int const& element,
+                                    Tolerance const& tolerance
+                                    = kEpsilon) const;
+
+  /// @brief Per-dimension factors P_i of the prolongation operator P = P_{d-1}
+  /// x ... x P_0 that maps coefficients of this parameter space to those of a
+  /// finer one, e.g., obtained by any sequence of knot insertions and degree
+  /// elevations, i.e., fine coefficients are given by P c.  The fine space must
+  /// contain this space, i.e., each interior knot has to be contained at least
+  /// as often as its multiplicity plus the degree elevation, otherwise a
+  /// DomainError is thrown.  Restriction operators are given by the
+  /// transposes.
+  /// @param fine
+  /// @param tolerance entries with smaller magnitude are dropped
+  /// @return
+  virtual ProlongationFactors_
+  DetermineProlongationFactors(ParameterSpace const& fine,
+                               Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Prolongation operator as CSR matrix, i.e., the Kronecker product
+  /// of the per-dimension factors.  Rows and columns are ordered like the
+  /// coordinates of splines, i.e., with the first dimension running fastest.
+  /// @param fine
+  /// @param tolerance
+  /// @return
+  virtual SparseMatrix_
+  DetermineProlongation(ParameterSpace const& fine,
+                        Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Number of elements of each dimension.
+  /// @param tolerance
+  /// @return
+  virtual Array<int, para_dim>
+  GetNumberOfElements(Tolerance const& tolerance = kEpsilon) const;
+
   /// @brief Return multiplicities of uninque_knots for each diemnsion
   /// @param tolerance
   virtual Vector<Vector<int>>
@@ -183,6 +321,14 @@ public:
   virtual BasisValuesPerDimension_
   EvaluateBasisValuesPerDimension(const Type_* parametric_coordinate,
                                   Tolerance const& tolerance = kEpsilon) const;
+  /// @brief Same as above, but evaluated on given effective knot spans (see
+  /// FindEffectiveKnotSpans), e.g., found beforehand for many coordinates.
+  /// @param parametric_coordinate
+  /// @param effective_knot_spans
+  /// @return
+  virtual BasisValuesPerDimension_
+  EvaluateBasisValuesPerDimension(const Type_* parametric_coordinate,
+                                  KnotSpans_ const& effective_knot_spans) const;
 
   virtual BasisValues_
   EvaluateBasisValues(const Type_* parametric_coordinate,
@@ -229,6 +375,16 @@ public:
                Multiplicity const& multiplicity = kMultiplicity,
                Tolerance const& tolerance = kEpsilon);
 
+  /// @brief Refines given dimension as a whole, see Refinement.
+  /// @param dimension
+  /// @param refinement
+  /// @param tolerance
+  /// @return prolongation factor from the previous to the refined basis of
+  /// this dimension
+  virtual SparseMatrix_ Refine(Dimension const& dimension,
+                               Refinement_ const& refinement,
+                               Tolerance const& tolerance = kEpsilon);
+
   virtual OutputInformation_
   Write(Precision const& precision = kPrecision) const;
 
@@ -296,6 +452,33 @@ protected:
   Degrees_ degrees_;
 
 private:
+  // Cached Bezier extraction operators together with the revision of the knots
+  // and the degree they were computed for, i.e., a cache hit is O(1).  Copies
+  // and moves start with an empty cache.
+  struct BezierExtractionCache_ {
+    struct Entry_ {
+      typename KnotVector::Revision_ revision_{};
+      int degree_{-1};
+      Tolerance tolerance_{};
+      SharedPointer<BezierExtractionInformation_ const> information_;
+    };
+
+    BezierExtractionCache_() = default;
+    BezierExtractionCache_(BezierExtractionCache_ const&) {}
+    BezierExtractionCache_(BezierExtractionCache_&&) noexcept {}
+    BezierExtractionCache_& operator=(BezierExtractionCache_ const&) {
+      return *this;
+    }
+    BezierExtractionCache_& operator=(BezierExtractionCache_&&) noexcept {
+      return *this;
+    }
+
+    std::mutex mutex_;
+    Array<Entry_, para_dim> entries_;
+  };
+
+  mutable BezierExtractionCache_ bezier_extraction_cache_;
+
   void CopyKnotVectors(KnotVectors_ const& knot_vectors);
 
   // Number of non-zero basis functions is equal to p+1 - see NURBS book P2.2.
@@ -312,6 +495,22 @@ private:
       Dimension const& dimension,
       Multiplicity const& multiplicity = kMultiplicity) const;
 
+  SparseMatrix_ DetermineProlongationFactor(Dimension const& dimension,
+                                            ParameterSpace const& fine,
+                                            Tolerance const& tolerance) const;
+
+  // Bezier coordinates of the p+1 basis functions that do not vanish on given
+  // knot span w.r.t. the interval [lower, upper] within this span.  Stored as
+  // row-major (p+1, p+1) matrix, where rows correspond to basis functions.
+  // Computed in Accumulation and rounded to BlossomType when stored.
+  template<typename BlossomType>
+  void DetermineBlossoms(Dimension const& dimension,
+                         int const& span,
+                         Knot_ const& lower,
+                         Knot_ const& upper,
+                         TemporaryData2D_<Accumulation>& workspace,
+                         BlossomType* blossoms) const;
+
 #ifndef NDEBUG
   void
   ThrowIfBasisFunctionIndexIsInvalid(Index_ const& basis_function_index) const;
@@ -365,72 +564,66 @@ BasisValues RecursiveCombine(const Array<BasisValues, array_dim>& factors) {
   return result;
 }
 
-/// recursive combime taken from bezman
+/// Combines the basis values per dimension like RecursiveCombine, but hands
+/// each basis function's index and value to accumulate, e.g., for coordinates
+/// that are not contiguous.  Products of basis values are formed in
+/// Accumulation.
+///
+/// index is a strided index over the non-zero basis functions whose strides
+/// are the ones of the coefficients, i.e., each step only adds a stride.
+/// Visiting all entries of a dimension wraps index around to where it started.
 template<std::size_t depth,
          std::size_t array_dim,
          typename ValueType,
-         typename BSplineLibIndex,
-         typename CoeffType,
-         typename ReturnType>
-constexpr void RecursiveCombine_(const Array<BasisValues, array_dim>& factors,
-                                 BSplineLibIndex& index,
-                                 BSplineLibIndex& index_offset,
-                                 const CoeffType& coeffs,
-                                 const ValueType& c_value,
-                                 ReturnType& result) {
+         typename StridedIndexType,
+         typename Accumulate>
+constexpr void
+RecursiveAccumulate_(const Array<BasisValues, array_dim>& factors,
+                     StridedIndexType& index,
+                     const ValueType& c_value,
+                     Accumulate& accumulate) {
   static_assert(depth < array_dim,
                 "Implementation error, recursion loop to deep!");
 
   for (const auto& factor : factors[depth]) {
     if constexpr (depth == 0) {
-      // get basis contribution
-      const auto fac = c_value * factor;
-      // add index offset and get beginning of corresponding control point
-      const auto& index_offset_multi_index = index_offset.MultiIndex();
-      index += index_offset_multi_index;
-      const auto* coeff = &coeffs(index.GetIndex1d(), 0);
-
-      // contribute to each dim
-      result.Add(fac, coeff);
-
-      // setback index offset
-      index -= index_offset_multi_index;
-      ;
-
-      // advance to the next index offset - this needs to be done after offset
-      // setback
-      ++index_offset;
+      accumulate(index.GetIndex1d(), c_value * factor);
     } else {
-      RecursiveCombine_<static_cast<std::size_t>(depth - 1)>(factors,
-                                                             index,
-                                                             index_offset,
-                                                             coeffs,
-                                                             c_value * factor,
-                                                             result);
+      RecursiveAccumulate_<static_cast<std::size_t>(depth - 1)>(
+          factors,
+          index,
+          c_value * factor,
+          accumulate);
     }
+    index.Increment(static_cast<Dimension>(depth));
   }
 }
 
-/// recursive combime adapted from bezman
-template<std::size_t array_dim,
-         typename BSplineLibIndex,
-         typename CoeffType,
-         typename ReturnType>
-constexpr void RecursiveCombine(const Array<BasisValues, array_dim>& factors,
-                                BSplineLibIndex& index,
-                                BSplineLibIndex& index_offset,
-                                const CoeffType& coeffs,
-                                ReturnType& result) {
-
-  // Start computation
-  RecursiveCombine_<array_dim - 1>(factors,
-                                   index,
-                                   index_offset,
-                                   coeffs,
-                                   1.,
-                                   result);
+template<std::size_t array_dim, typename StridedIndexType, typename Accumulate>
+constexpr void RecursiveAccumulate(const Array<BasisValues, array_dim>& factors,
+                                   StridedIndexType& index,
+                                   Accumulate accumulate) {
+  RecursiveAccumulate_<array_dim - 1>(factors,
+                                      index,
+                                      Accumulation{1},
+                                      accumulate);
 }
 
+/// Index for RecursiveAccumulate over values stored contiguously in the order
+/// of traversal, e.g., packed element coordinates.  Only the innermost
+/// dimension advances it, i.e., it counts the visited basis functions.
+struct ContiguousIndex {
+  Index index_1d_{};
+
+  constexpr Index const& GetIndex1d() const { return index_1d_; }
+  constexpr ContiguousIndex& Increment(Dimension const& dimension) {
+    if (dimension == 0) {
+      ++index_1d_;
+    }
+    return *this;
+  }
+};
+
 #include "BSplineLib/ParameterSpaces/parameter_space.inl"
 
 } // namespace bsplinelib::parameter_spaces
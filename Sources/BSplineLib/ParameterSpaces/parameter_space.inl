@@ -48,7 +48,7 @@ typename ParameterSpace<para_dim>::NumberOfBasisFunctions_
 ParameterSpace<para_dim>::GetNumberOfBasisFunctions() const {
   NumberOfBasisFunctions_ number_of_basis_functions;
   int i{};
-  for (int& nobf : number_of_basis_functions) {
+  for (Length& nobf : number_of_basis_functions) {
     nobf = GetNumberOfBasisFunctions(i++);
   }
   assert(i == para_dim);
@@ -57,7 +57,7 @@ ParameterSpace<para_dim>::GetNumberOfBasisFunctions() const {
 }
 
 template<int para_dim>
-int ParameterSpace<para_dim>::GetTotalNumberOfBasisFunctions() const {
+Index ParameterSpace<para_dim>::GetTotalNumberOfBasisFunctions() const {
   NumberOfBasisFunctions_ const& number_of_basis_functions =
       GetNumberOfBasisFunctions();
   return std::reduce(number_of_basis_functions.begin(),
@@ -116,6 +116,16 @@ ParameterSpace<para_dim>::FindFirstNonZeroBasisFunction(
   return first_support;
 }
 
+template<int para_dim>
+typename ParameterSpace<para_dim>::StridedIndex_
+ParameterSpace<para_dim>::FindNonZeroBasisFunctions(
+    const Type_* parametric_coordinate,
+    Tolerance const& tolerance) const {
+  return StridedIndex_{
+      GetNumberOfNonZeroBasisFunctions(),
+      FindFirstNonZeroBasisFunction(parametric_coordinate, tolerance)};
+}
+
 template<int para_dim>
 typename ParameterSpace<para_dim>::KnotSpans_
 ParameterSpace<para_dim>::FindKnotSpans(const Type_* parametric_coordinate,
@@ -127,6 +137,60 @@ ParameterSpace<para_dim>::FindKnotSpans(const Type_* parametric_coordinate,
   return out;
 }
 
+template<int para_dim>
+typename ParameterSpace<para_dim>::KnotSpans_
+ParameterSpace<para_dim>::FindEffectiveKnotSpans(
+    const Type_* parametric_coordinate,
+    Tolerance const& tolerance) const {
+  KnotSpans_ effective_knot_spans;
+  for (int i{}; i < para_dim; ++i) {
+    effective_knot_spans[i] =
+        knot_vectors_[i]->FindEffectiveSpan(parametric_coordinate[i],
+                                            degrees_[i],
+                                            tolerance);
+  }
+  return effective_knot_spans;
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::EvaluationOrder_
+ParameterSpace<para_dim>::DetermineEvaluationOrder(
+    const Type_* parametric_coordinates,
+    Index const& number_of_parametric_coordinates,
+    Tolerance const& tolerance) const {
+  // Morton code of the element, i.e., bits of its (non-negative) knot spans
+  // interleaved, is the primary key and the index of the coordinate the
+  // secondary one.
+  constexpr int kNumberOfBits{std::min(64 / para_dim, 31)};
+  Vector<std::pair<std::uint64_t, Index>> keys(
+      number_of_parametric_coordinates);
+  Vector<KnotSpans_> effective_knot_spans(number_of_parametric_coordinates);
+  for (Index j{}; j < number_of_parametric_coordinates; ++j) {
+    KnotSpans_ const& spans = effective_knot_spans[j] =
+        FindEffectiveKnotSpans(parametric_coordinates + j * para_dim,
+                               tolerance);
+    std::uint64_t code{};
+    for (int bit{}; bit < kNumberOfBits; ++bit) {
+      for (int i{}; i < para_dim; ++i) {
+        code |= static_cast<std::uint64_t>((spans[i].Get() >> bit) & 1)
+                << (bit * para_dim + i);
+      }
+    }
+    keys[j] = {code, j};
+  }
+  std::sort(keys.begin(), keys.end());
+
+  EvaluationOrder_ evaluation_order;
+  auto& [order, ordered_knot_spans] = evaluation_order;
+  order.reserve(number_of_parametric_coordinates);
+  ordered_knot_spans.reserve(number_of_parametric_coordinates);
+  for (auto const& [code, j] : keys) {
+    order.push_back(j);
+    ordered_knot_spans.push_back(effective_knot_spans[j]);
+  }
+  return evaluation_order;
+}
+
 template<int para_dim>
 typename ParameterSpace<para_dim>::BezierInformation_
 ParameterSpace<para_dim>::DetermineBezierExtractionKnots(
@@ -138,26 +202,174 @@ ParameterSpace<para_dim>::DetermineBezierExtractionKnots(
 
   KnotVector const& knot_vector = *knot_vectors_[dimension];
   Knots_ const& unique_knots = knot_vector.GetUniqueKnots(tolerance);
-  typename Knots_::const_iterator const &first_interior_knot =
-                                            (unique_knots.begin() + 1),
-                                        &last_knot =
-                                            std::prev(unique_knots.end());
-  int const& number_of_interior_knots = (last_knot - first_interior_knot);
+  Vector<int> const& multiplicities =
+      knot_vector.DetermineMultiplicities(tolerance);
+  int const& number_of_interior_knots =
+      static_cast<int>(unique_knots.size()) - 2;
   Knots_ bezier_extraction_knots;
   bezier_extraction_knots.reserve(number_of_interior_knots);
-  std::for_each(first_interior_knot,
-                last_knot,
-                [&](ParametricCoordinate const& interior_knot) {
-                  std::fill_n(
-                      std::back_inserter(bezier_extraction_knots),
-                      degrees_[dimension]
-                          - knot_vector.DetermineMultiplicity(interior_knot),
-                      interior_knot);
-                });
+  for (int i{1}; i <= number_of_interior_knots; ++i) {
+    std::fill_n(std::back_inserter(bezier_extraction_knots),
+                degrees_[dimension] - multiplicities[i],
+                unique_knots[i]);
+  }
   return BezierInformation_{number_of_interior_knots + 1,
                             bezier_extraction_knots};
 }
 
+template<int para_dim>
+typename ParameterSpace<para_dim>::ElementSpans_
+ParameterSpace<para_dim>::DetermineElementSpans(
+    Dimension const& dimension,
+    Tolerance const& tolerance) const {
+  assert(tolerance > 0.0);
+  DimensionBoundCheck(BSPLINELIB_FUNC(), dimension, true);
+
+  KnotVector const& knot_vector = *knot_vectors_[dimension];
+  const Knot_* knots = knot_vector.GetData();
+  const int degree = degrees_[dimension];
+  const int number_of_basis_functions = GetNumberOfBasisFunctions(dimension);
+
+  ElementSpans_ element_spans;
+  element_spans.reserve(number_of_basis_functions - degree);
+  for (int span{degree}; span < number_of_basis_functions; ++span) {
+    if (knots[span + 1] - knots[span] > tolerance) {
+      element_spans.push_back(span);
+    }
+  }
+
+  return element_spans;
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::BezierExtractionInformation_
+ParameterSpace<para_dim>::DetermineBezierExtractionOperators(
+    Dimension const& dimension,
+    Tolerance const& tolerance) const {
+  ElementSpans_ element_spans{DetermineElementSpans(dimension, tolerance)};
+
+  KnotVector const& knot_vector = *knot_vectors_[dimension];
+  const Knot_* knots = knot_vector.GetData();
+  const int n_basis = degrees_[dimension] + 1;
+  const int n_elements = static_cast<int>(element_spans.size());
+
+  BezierExtractionOperators_ operators(n_elements, n_basis, n_basis);
+  TemporaryData2D_<Accumulation> workspace(n_basis, n_basis);
+  for (int e{}; e < n_elements; ++e) {
+    const int& span = element_spans[e];
+    DetermineBlossoms(dimension,
+                      span,
+                      knots[span],
+                      knots[span + 1],
+                      workspace,
+                      &operators(e, 0, 0));
+  }
+
+  return BezierExtractionInformation_{std::move(element_spans),
+                                      std::move(operators)};
+}
+
+template<int para_dim>
+SharedPointer<
+    typename ParameterSpace<para_dim>::BezierExtractionInformation_ const>
+ParameterSpace<para_dim>::GetBezierExtractionOperators(
+    Dimension const& dimension,
+    Tolerance const& tolerance) const {
+  DimensionBoundCheck(BSPLINELIB_FUNC(), dimension, true);
+
+  auto const& revision = knot_vectors_[dimension]->GetRevision();
+  const int& degree = degrees_[dimension];
+
+  std::lock_guard<std::mutex> lock(bezier_extraction_cache_.mutex_);
+  auto& entry = bezier_extraction_cache_.entries_[dimension];
+  if (!entry.information_ || entry.revision_ != revision
+      || entry.degree_ != degree || entry.tolerance_ != tolerance) {
+    entry.information_ = std::make_shared<BezierExtractionInformation_ const>(
+        DetermineBezierExtractionOperators(dimension, tolerance));
+    entry.revision_ = revision;
+    entry.degree_ = degree;
+    entry.tolerance_ = tolerance;
+  }
+  return entry.information_;
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::BezierExtractionOperator_
+ParameterSpace<para_dim>::DetermineBezierExtractionOperator(
+    int const& element,
+    Tolerance const& tolerance) const {
+  Array<SharedPointer<BezierExtractionInformation_ const>, para_dim>
+      information;
+  Array<int, para_dim> element_per_dimension, number_of_bezier_points;
+  int remainder{element}, size{1};
+  for (int i{}; i < para_dim; ++i) {
+    information[i] = GetBezierExtractionOperators(Dimension{i}, tolerance);
+    const int number_of_elements =
+        static_cast<int>(std::get<0>(*information[i]).size());
+    element_per_dimension[i] = remainder % number_of_elements;
+    remainder /= number_of_elements;
+    number_of_bezier_points[i] = degrees_[i] + 1;
+    size *= number_of_bezier_points[i];
+  }
+  if (element < 0 || remainder != 0) {
+    throw OutOfRange("ParameterSpace::DetermineBezierExtractionOperator - "
+                     "element "
+                     + std::to_string(element) + " is out of bound.");
+  }
+
+  BezierExtractionOperator_ extraction_operator(size, size);
+  extraction_operator.Fill(1.0);
+  int stride{1};
+  for (int i{}; i < para_dim; ++i) {
+    const auto& operators = std::get<1>(*information[i]);
+    const int& n = number_of_bezier_points[i];
+    for (int a{}; a < size; ++a) {
+      const int a_i = (a / stride) % n;
+      for (int b{}; b < size; ++b) {
+        extraction_operator(a, b) *=
+            operators(element_per_dimension[i], a_i, (b / stride) % n);
+      }
+    }
+    stride *= n;
+  }
+
+  return extraction_operator;
+}
+
+template<int para_dim>
+Array<int, para_dim>
+ParameterSpace<para_dim>::GetNumberOfElements(
+    Tolerance const& tolerance) const {
+  Array<int, para_dim> number_of_elements;
+  for (int i{}; i < para_dim; ++i) {
+    number_of_elements[i] = static_cast<int>(
+        std::get<0>(*GetBezierExtractionOperators(Dimension{i}, tolerance))
+            .size());
+  }
+  return number_of_elements;
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::ProlongationFactors_
+ParameterSpace<para_dim>::DetermineProlongationFactors(
+    ParameterSpace const& fine,
+    Tolerance const& tolerance) const {
+  ProlongationFactors_ factors;
+  for (int i{}; i < para_dim; ++i) {
+    factors[i] = DetermineProlongationFactor(i, fine, tolerance);
+  }
+  return factors;
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::SparseMatrix_
+ParameterSpace<para_dim>::DetermineProlongation(
+    ParameterSpace const& fine,
+    Tolerance const& tolerance) const {
+  return utilities::containers::KroneckerProduct(
+      DetermineProlongationFactors(fine, tolerance));
+}
+
 template<int para_dim>
 Vector<Vector<int>>
 ParameterSpace<para_dim>::KnotMultiplicities(Tolerance const& tolerance) const {
@@ -177,6 +389,16 @@ typename ParameterSpace<para_dim>::BasisValuesPerDimension_
 ParameterSpace<para_dim>::EvaluateBasisValuesPerDimension(
     const Type_* parametric_coordinate,
     Tolerance const& tolerance) const {
+  return EvaluateBasisValuesPerDimension(
+      parametric_coordinate,
+      FindEffectiveKnotSpans(parametric_coordinate, tolerance));
+}
+
+template<int para_dim>
+typename ParameterSpace<para_dim>::BasisValuesPerDimension_
+ParameterSpace<para_dim>::EvaluateBasisValuesPerDimension(
+    const Type_* parametric_coordinate,
+    KnotSpans_ const& effective_knot_spans) const {
 
   // prepare output
   BasisValuesPerDimension_ output;
@@ -186,23 +408,17 @@ ParameterSpace<para_dim>::EvaluateBasisValuesPerDimension(
     const auto& this_dim_degree = degrees_[i];
     const auto this_dim_n_basis = this_dim_degree + 1;
     const auto& this_dim_parametric_coordinate = parametric_coordinate[i];
-    const auto& this_knot_vector = *knot_vectors_[i];
-    const auto& this_knots = this_knot_vector.GetKnots();
-    const int this_zero_degree_support =
-        this_knot_vector
-            .FindEffectiveSpan(this_dim_parametric_coordinate,
-                               this_dim_degree,
-                               tolerance)
-            .Get();
+    const Knot_* this_knots = knot_vectors_[i]->GetData();
+    const int this_zero_degree_support = effective_knot_spans[i].Get();
 
     // this dim's output
     auto& this_dim_output = output[i];
     this_dim_output.Reallocate(this_dim_n_basis);
     this_dim_output[0] = 1.;
 
-    TemporaryData_<double> left(this_dim_n_basis), right(this_dim_n_basis);
+    TemporaryData_<Type_> left(this_dim_n_basis), right(this_dim_n_basis);
 
-    double saved, temp;
+    Type_ saved, temp;
 
     for (int k{1}; k < this_dim_n_basis; ++k) {
       this_dim_output[k] = 1.;
@@ -263,7 +479,7 @@ ParameterSpace<para_dim>::EvaluateBasisDerivativeValuesPerDimension(
 
     const auto& this_dim_parametric_coordinate = parametric_coordinate[i];
     const auto& this_knot_vector = *knot_vectors_[i];
-    const auto& this_knots = this_knot_vector.GetKnots();
+    const Knot_* this_knots = this_knot_vector.GetData();
     const int this_zero_degree_support =
         this_knot_vector
             .FindEffectiveSpan(this_dim_parametric_coordinate,
@@ -272,8 +488,8 @@ ParameterSpace<para_dim>::EvaluateBasisDerivativeValuesPerDimension(
             .Get();
 
     // temporary ones that we need for second special case
-    TemporaryData_<double> left(this_dim_n_basis), right(this_dim_n_basis);
-    double saved, temp, d;
+    TemporaryData_<Type_> left(this_dim_n_basis), right(this_dim_n_basis);
+    Type_ saved, temp, d;
 
     // special case 2 - derivative 0 query is evaluation query
     if (this_dim_derivative == 0) {
@@ -301,7 +517,7 @@ ParameterSpace<para_dim>::EvaluateBasisDerivativeValuesPerDimension(
 
     // here, proper derivative query.
     // more temporary variables
-    TemporaryData2D_<double> a(2, this_dim_n_basis),
+    TemporaryData2D_<Type_> a(2, this_dim_n_basis),
         ndu(this_dim_n_basis, this_dim_n_basis);
     int j1, j2;
 
@@ -493,6 +709,42 @@ ParameterSpace<para_dim>::ReduceDegree(Dimension const& dimension,
   return DetermineElevationInformation(dimension, reduction);
 }
 
+template<int para_dim>
+typename ParameterSpace<para_dim>::SparseMatrix_
+ParameterSpace<para_dim>::Refine(Dimension const& dimension,
+                                 Refinement_ const& refinement,
+                                 Tolerance const& tolerance) {
+  assert(tolerance > 0.0);
+  DimensionBoundCheck(BSPLINELIB_FUNC(), dimension, true);
+
+  const int elevation =
+      (refinement.degree_ < 0) ? 0 : refinement.degree_ - degrees_[dimension];
+  if (elevation < 0) {
+    throw DomainError("ParameterSpace::Refine - degree "
+                      + std::to_string(refinement.degree_)
+                      + " is smaller than the current degree of dimension "
+                      + std::to_string(dimension) + ".");
+  }
+
+  ParameterSpace const coarse{*this};
+  auto const insert_knots = [&]() {
+    for (Knot_ const& knot : refinement.knots_) {
+      InsertKnot(dimension, knot, kMultiplicity, tolerance);
+    }
+  };
+  if (refinement.insert_knots_first_) {
+    insert_knots();
+  }
+  if (elevation > 0) {
+    ElevateDegree(dimension, elevation, tolerance);
+  }
+  if (!refinement.insert_knots_first_) {
+    insert_knots();
+  }
+
+  return coarse.DetermineProlongationFactor(dimension, *this, tolerance);
+}
+
 template<int para_dim>
 typename ParameterSpace<para_dim>::OutputInformation_
 ParameterSpace<para_dim>::Write(Precision const& precision) const {
@@ -555,6 +807,219 @@ Length ParameterSpace<para_dim>::GetNumberOfBasisFunctions(
                 - GetNumberOfNonZeroBasisFunctions(dimension)};
 }
 
+// Fine basis functions are represented on each fine element by M_e = C_e E
+// D_e^{-1}, where C_e and D_e are the Bezier coordinates of the coarse and
+// fine basis functions on the element and E elevates the Bernstein
+// polynomials to the fine degree.
+template<int para_dim>
+typename ParameterSpace<para_dim>::SparseMatrix_
+ParameterSpace<para_dim>::DetermineProlongationFactor(
+    Dimension const& dimension,
+    ParameterSpace const& fine,
+    Tolerance const& tolerance) const {
+  using utilities::math_operations::DetermineElevationCoefficients,
+      utilities::math_operations::ElevationCoefficients,
+      utilities::math_operations::SolveLinearSystem;
+
+  KnotVector const &knot_vector = *knot_vectors_[dimension],
+                   &fine_knot_vector = *fine.knot_vectors_[dimension];
+  const Knot_ *knots = knot_vector.GetData(),
+              *fine_knots = fine_knot_vector.GetData();
+  const int &degree = degrees_[dimension],
+            &fine_degree = fine.degrees_[dimension];
+  if (fine_degree < degree
+      || std::abs(knot_vector.GetFront() - fine_knot_vector.GetFront())
+             > tolerance
+      || std::abs(knot_vector.GetBack() - fine_knot_vector.GetBack())
+             > tolerance) {
+    throw DomainError(
+        "ParameterSpace::DetermineProlongationFactor - parameter space of "
+        "dimension "
+        + std::to_string(dimension) + " is not a refinement.");
+  }
+
+  const int n_basis = degree + 1, n_fine_basis = fine_degree + 1,
+            elevation = fine_degree - degree;
+
+  // nested, i.e., each interior knot of multiplicity m is contained in the
+  // fine knot vector at least m + elevation times (same continuity)
+  {
+    Knots_ const &unique_knots = knot_vector.GetUniqueKnots(tolerance),
+                 &fine_unique_knots =
+                     fine_knot_vector.GetUniqueKnots(tolerance);
+    Vector<int> const
+        &multiplicities = knot_vector.DetermineMultiplicities(tolerance),
+        &fine_multiplicities =
+            fine_knot_vector.DetermineMultiplicities(tolerance);
+    std::size_t j{};
+    for (std::size_t i{1}; i + 1 < unique_knots.size(); ++i) {
+      while (j < fine_unique_knots.size()
+             && fine_unique_knots[j] < unique_knots[i] - tolerance) {
+        ++j;
+      }
+      const int fine_multiplicity =
+          (j < fine_unique_knots.size()
+           && std::abs(fine_unique_knots[j] - unique_knots[i]) <= tolerance)
+              ? fine_multiplicities[j]
+              : 0;
+      if (fine_multiplicity < multiplicities[i] + elevation) {
+        throw DomainError(
+            "ParameterSpace::DetermineProlongationFactor - parameter space of "
+            "dimension "
+            + std::to_string(dimension) + " is not a refinement.");
+      }
+    }
+  }
+  const int number_of_basis_functions = GetNumberOfBasisFunctions(dimension),
+            number_of_fine_basis_functions =
+                fine.GetNumberOfBasisFunctions(dimension);
+
+  // Bernstein degree elevation, first and last rows are the identity
+  ElevationCoefficients const& elevation_coefficients =
+      DetermineElevationCoefficients(degree, elevation);
+  TemporaryData2D_<Accumulation> elevation_matrix(n_basis, n_fine_basis);
+  for (int b{}; b < n_basis; ++b) {
+    for (int k{}; k < n_fine_basis; ++k) {
+      if (k < b || k > b + elevation) {
+        elevation_matrix(b, k) = 0.0;
+      } else if (k == 0 || k == fine_degree) {
+        elevation_matrix(b, k) = 1.0;
+      } else {
+        elevation_matrix(b, k) =
+            elevation_coefficients[k - 1][b - std::max(0, k - elevation)];
+      }
+    }
+  }
+
+  // local operators are computed and solved for in Accumulation
+  TemporaryData2D_<Accumulation> coarse_blossoms(n_basis, n_basis),
+      fine_blossoms(n_fine_basis, n_fine_basis),
+      workspace(n_fine_basis, n_fine_basis),
+      local_prolongation(n_fine_basis, n_basis);
+
+  SparseMatrix_ factor;
+  factor.number_of_rows_ = number_of_fine_basis_functions;
+  factor.number_of_columns_ = number_of_basis_functions;
+  factor.row_offsets_.reserve(number_of_fine_basis_functions + 1);
+  factor.column_indices_.reserve(number_of_fine_basis_functions * n_basis);
+  factor.values_.reserve(number_of_fine_basis_functions * n_basis);
+
+  // each row is taken from the first element it is active on, i.e., rows
+  // are completed in order
+  int next_row{};
+  for (const int& fine_span :
+       fine.DetermineElementSpans(dimension, tolerance)) {
+    const int first_fine = fine_span - fine_degree;
+    if (first_fine + fine_degree < next_row) {
+      continue;
+    }
+    const Knot_ &lower = fine_knots[fine_span],
+                &upper = fine_knots[fine_span + 1];
+    const Knot_ center = 0.5 * (lower + upper);
+    const int span = std::clamp(
+        static_cast<int>(
+            std::upper_bound(knots, knots + knot_vector.GetSize(), center)
+            - knots)
+            - 1,
+        degree,
+        number_of_basis_functions - 1);
+    const int first = span - degree;
+
+    DetermineBlossoms(dimension,
+                      span,
+                      lower,
+                      upper,
+                      workspace,
+                      coarse_blossoms.data_);
+    fine.DetermineBlossoms(dimension,
+                           fine_span,
+                           lower,
+                           upper,
+                           workspace,
+                           fine_blossoms.data_);
+
+    // D_e^T M_e^T = (C_e E)^T
+    for (int k{}; k < n_fine_basis; ++k) {
+      for (int a{}; a < n_basis; ++a) {
+        Accumulation value{};
+        for (int b{}; b < n_basis; ++b) {
+          value += coarse_blossoms(a, b) * elevation_matrix(b, k);
+        }
+        local_prolongation(k, a) = value;
+      }
+      for (int a{}; a < n_fine_basis; ++a) {
+        workspace(k, a) = fine_blossoms(a, k);
+      }
+    }
+    SolveLinearSystem(n_fine_basis,
+                      n_basis,
+                      workspace.data_,
+                      local_prolongation.data_);
+
+    for (int a{next_row - first_fine}; a < n_fine_basis; ++a) {
+      for (int b{}; b < n_basis; ++b) {
+        const Accumulation& value = local_prolongation(a, b);
+        if (std::abs(value) > tolerance) {
+          factor.column_indices_.push_back(first + b);
+          factor.values_.push_back(static_cast<Type_>(value));
+        }
+      }
+      factor.row_offsets_.push_back(static_cast<Index>(factor.values_.size()));
+    }
+    next_row = first_fine + n_fine_basis;
+  }
+
+  return factor;
+}
+
+// Cf. NURBS book Sec. 5.3 - Bezier points of an element are blossoms of its
+// end points, i.e., C(a, b) = N_{span-p+a}[lower^(p-b), upper^b].
+template<int para_dim>
+template<typename BlossomType>
+void ParameterSpace<para_dim>::DetermineBlossoms(
+    Dimension const& dimension,
+    int const& span,
+    Knot_ const& lower,
+    Knot_ const& upper,
+    TemporaryData2D_<Accumulation>& workspace,
+    BlossomType* blossoms) const {
+  KnotVector const& knot_vector = *knot_vectors_[dimension];
+  const Knot_* knots = knot_vector.GetData();
+  const int degree = degrees_[dimension];
+  const int n_basis = degree + 1;
+  const int first = span - degree;
+
+  // de Boor's triangle applied to unit control points. row l holds the
+  // coefficients of the l-th intermediate point w.r.t. the local basis
+  for (int b{}; b < n_basis; ++b) {
+    for (int l{}; l < n_basis; ++l) {
+      for (int a{}; a < n_basis; ++a) {
+        workspace(l, a) = (l == a) ? 1.0 : 0.0;
+      }
+    }
+
+    // b times the upper bound and p - b times the lower bound as arguments
+    for (int r{1}; r < n_basis; ++r) {
+      const Knot_& argument = (r <= b) ? upper : lower;
+      for (int l{degree}; l >= r; --l) {
+        const Knot_& left_knot = knots[first + l];
+        const Accumulation alpha =
+            (static_cast<Accumulation>(argument) - left_knot)
+            / (static_cast<Accumulation>(knots[span + 1 + l - r]) - left_knot);
+        for (int a{}; a < n_basis; ++a) {
+          workspace(l, a) =
+              (1.0 - alpha) * workspace(l - 1, a) + alpha * workspace(l, a);
+        }
+      }
+    }
+
+    for (int a{}; a < n_basis; ++a) {
+      blossoms[a * n_basis + b] =
+          static_cast<BlossomType>(workspace(degree, a));
+    }
+  }
+}
+
 // Cf. NURBS book below Eq. (5.15).
 template<int para_dim>
 typename ParameterSpace<para_dim>::InsertionInformation_
@@ -594,30 +1059,17 @@ typename ParameterSpace<para_dim>::ElevationInformation_
 ParameterSpace<para_dim>::DetermineElevationInformation(
     Dimension const& dimension,
     Multiplicity const& multiplicity) const {
-  using utilities::math_operations::ComputeBinomialCoefficient;
+  using utilities::math_operations::DetermineElevationCoefficients,
+      utilities::math_operations::ElevationCoefficients;
 
   Degree const& degree = degrees_[dimension];
-  const int maximum_bezier_coordinate = (degree + multiplicity);
-  ElevationCoefficients_ bezier_coefficients;
-  bezier_coefficients.reserve(maximum_bezier_coordinate - 1);
-
-  for (int i{1}; i < maximum_bezier_coordinate; ++i) {
-    const int bezier_coordinate_begin{std::max(0, i - multiplicity)};
-    const int bezier_coordinate_end{std::min(degree, i) + 1};
-    // Capturing result by reference produces dangling references if maxima
-    // of the parameters are temporaries.
-
-    BinomialRatios_ current_bezier_coefficients(
-        bezier_coordinate_end - bezier_coordinate_begin,
-        1.0 / ComputeBinomialCoefficient(maximum_bezier_coordinate, i));
-
-    for (int j{bezier_coordinate_begin}; j < bezier_coordinate_end; ++j) {
-      current_bezier_coefficients[j - bezier_coordinate_begin] *=
-          (ComputeBinomialCoefficient(degree, j)
-           * ComputeBinomialCoefficient(multiplicity, i - j));
-    }
-    bezier_coefficients.push_back(current_bezier_coefficients);
+  // tabulated in double precision
+  ElevationCoefficients const& coefficients =
+      DetermineElevationCoefficients(degree, multiplicity);
+  ElevationCoefficients_ elevation_coefficients;
+  elevation_coefficients.reserve(coefficients.size());
+  for (auto const& row : coefficients) {
+    elevation_coefficients.emplace_back(row.begin(), row.end());
   }
-
-  return ElevationInformation_{Index{degree}, bezier_coefficients};
+  return ElevationInformation_{degree, std::move(elevation_coefficients)};
 }
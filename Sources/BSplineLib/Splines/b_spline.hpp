@@ -21,8 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #define SOURCES_SPLINES_B_SPLINE_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <iterator>
+#include <mutex>
 #include <utility>
 
 #include "BSplineLib/Splines/spline.hpp"
@@ -31,12 +33,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Utilities/index.hpp"
 #include "BSplineLib/Utilities/named_type.hpp"
 #include "BSplineLib/Utilities/numeric_operations.hpp"
+#include "BSplineLib/Utilities/parallel_operations.hpp"
 #include "BSplineLib/VectorSpaces/vector_space.hpp"
 
 namespace bsplinelib::splines {
 
 template<int para_dim>
 class BSpline;
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+class StaticBSpline;
 
 // B-splines are non-rational splines.  Currently only single-patch B-splines
 // are supported.
@@ -54,17 +59,28 @@ class BSpline : public Spline<para_dim> {
 public:
   using Base_ = Spline<para_dim>;
   using Coordinate_ = typename Base_::Coordinate_;
+  using Coordinates_ = typename Base_::Coordinates_;
   using Derivative_ = typename Base_::Derivative_;
+  using ExecutionPolicy_ = typename Base_::ExecutionPolicy_;
   using Knot_ = typename Base_::Knot_;
   using ParameterSpace_ = typename Base_::ParameterSpace_;
   using ParametricCoordinate_ = typename Base_::ParametricCoordinate_;
+  using RefinementPlan_ = typename Base_::RefinementPlan_;
   using VectorSpace_ = typename Base_::VectorSpace_;
+  using Fields_ = Vector<SharedPointer<VectorSpace_>>;
   using OutputInformation_ = Tuple<typename ParameterSpace_::OutputInformation_,
                                    typename VectorSpace_::OutputInformation_>;
 
   using Type_ = typename ParameterSpace_::Type_;
   using IntType_ = typename ParameterSpace_::IntType_;
 
+  // Bounds of each element with shape (number of elements, 2 * para_dim).
+  // Lower bounds of all dimensions are followed by upper bounds.
+  using ParametricBounds_ = bsplinelib::utilities::containers::Data<Type_, 2>;
+  using BezierPatches_ = Tuple<Coordinates_, ParametricBounds_>;
+  // splines covering [front, knot] and [knot, back] of the split dimension
+  using Split_ = Array<SharedPointer<BSpline>, 2>;
+
   BSpline();
   BSpline(SharedPointer<ParameterSpace_> parameter_space,
           SharedPointer<VectorSpace_> vector_space);
@@ -81,6 +97,25 @@ public:
                           const IntType_* derivative,
                           Type_* evaluated) const;
 
+  /// @brief Evaluates the spline at many parametric coordinates.  If
+  /// order_by_element, they are evaluated in the order of their elements along
+  /// a Morton curve (see ParameterSpace::DetermineEvaluationOrder), i.e.,
+  /// neighbouring evaluations share knot spans and control points, and reuse
+  /// the knot spans found for ordering.  As ordering sorts serially, it only
+  /// pays off for large batches of scattered coordinates.  Results are written
+  /// in the order of the coordinates.
+  /// @param parametric_coordinates (number_of_parametric_coordinates x
+  /// para_dim) array
+  /// @param number_of_parametric_coordinates
+  /// @param evaluated (number_of_parametric_coordinates x dim) array
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @param order_by_element
+  void EvaluateBatch(const Type_* parametric_coordinates,
+                     Index const& number_of_parametric_coordinates,
+                     Type_* evaluated,
+                     ExecutionPolicy_ const& execution_policy = {},
+                     bool const& order_by_element = false) const;
+
   /// @brief returning evaluate. kept for backward compatibility
   /// @param parametric_coordinate
   /// @param tolerance
@@ -97,26 +132,133 @@ public:
   void InsertKnot(Dimension const& dimension,
                   Knot_ knot,
                   Multiplicity const& multiplicity = kMultiplicity,
-                  Tolerance const& tolerance = kEpsilon) const override;
+                  Tolerance const& tolerance = kEpsilon,
+                  ExecutionPolicy_ const& execution_policy =
+                      Base_::GetDefaultExecutionPolicy()) const override;
   // Tries to interpret knot removal as the inverse process of knot insertion.
-  Multiplicity RemoveKnot(Dimension const& dimension,
-                          Knot_ const& knot,
-                          Tolerance const& tolerance_removal,
-                          Multiplicity const& multiplicity = kMultiplicity,
-                          Tolerance const& tolerance = kEpsilon) const override;
+  Multiplicity
+  RemoveKnot(Dimension const& dimension,
+             Knot_ const& knot,
+             Tolerance const& tolerance_removal,
+             Multiplicity const& multiplicity = kMultiplicity,
+             Tolerance const& tolerance = kEpsilon,
+             ExecutionPolicy_ const& execution_policy =
+                 Base_::GetDefaultExecutionPolicy()) const override;
   void ElevateDegree(Dimension const& dimension,
                      Multiplicity const& multiplicity = kMultiplicity,
-                     Tolerance const& tolerance = kEpsilon) const override;
+                     Tolerance const& tolerance = kEpsilon,
+                     ExecutionPolicy_ const& execution_policy =
+                         Base_::GetDefaultExecutionPolicy()) const override;
   // Tries to interpret degree reduction as the inverse process of degree
   // elevation.
   bool ReduceDegree(Dimension const& dimension,
                     Tolerance const& tolerance_reduction,
                     Multiplicity const& multiplicity = kMultiplicity,
-                    Tolerance const& tolerance = kEpsilon) const override;
+                    Tolerance const& tolerance = kEpsilon,
+                    ExecutionPolicy_ const& execution_policy =
+                        Base_::GetDefaultExecutionPolicy()) const override;
+
+  /// @brief Inserts the knot and updates this spline's coordinates as well as
+  /// the coordinates of all fields, i.e., of vector spaces associated with
+  /// this spline's parameter space (e.g., solution fields of splines sharing
+  /// it). The parameter space and the insertion coefficients are updated and
+  /// determined only once, lines of all fields are rebuilt in parallel.
+  /// @param fields vector spaces with one coordinate per basis function
+  /// @param dimension
+  /// @param knot
+  /// @param multiplicity
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  void InsertKnot(Fields_ const& fields,
+                  Dimension const& dimension,
+                  Knot_ knot,
+                  Multiplicity const& multiplicity = kMultiplicity,
+                  Tolerance const& tolerance = kEpsilon,
+                  ExecutionPolicy_ const& execution_policy =
+                      Base_::GetDefaultExecutionPolicy()) const;
+  /// @brief Elevates the degree of this spline and all fields by means of a
+  /// single prolongation factor. See InsertKnot(fields, ...).
+  /// @param fields vector spaces with one coordinate per basis function
+  /// @param dimension
+  /// @param multiplicity
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  void ElevateDegree(Fields_ const& fields,
+                     Dimension const& dimension,
+                     Multiplicity const& multiplicity = kMultiplicity,
+                     Tolerance const& tolerance = kEpsilon,
+                     ExecutionPolicy_ const& execution_policy =
+                         Base_::GetDefaultExecutionPolicy()) const;
+
+  /// @brief Executes the plan dimension by dimension. Per dimension, the
+  /// prolongation factor of the whole refinement is applied to all lines of
+  /// coordinates at once, i.e., the coordinates are rebuilt once with their
+  /// final size.
+  /// @param plan
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  void Refine(RefinementPlan_ const& plan,
+              Tolerance const& tolerance = kEpsilon,
+              ExecutionPolicy_ const& execution_policy =
+                  Base_::GetDefaultExecutionPolicy()) const override;
+  /// @brief Executes the plan for this spline and all fields. See
+  /// InsertKnot(fields, ...).
+  /// @param fields vector spaces with one coordinate per basis function
+  /// @param plan
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  void Refine(Fields_ const& fields,
+              RefinementPlan_ const& plan,
+              Tolerance const& tolerance = kEpsilon,
+              ExecutionPolicy_ const& execution_policy =
+                  Base_::GetDefaultExecutionPolicy()) const;
+
+  /// @brief Splits this spline at the knot into two independent splines
+  /// without modifying it. The knot is raised to multiplicity p once and the
+  /// coordinates of each side are computed directly from the ones of this
+  /// spline, i.e., neither this spline nor its refined net are copied.
+  /// @param dimension
+  /// @param knot has to lie in the interior of the dimension
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @return
+  Split_ Split(Dimension const& dimension,
+               Knot_ const& knot,
+               Tolerance const& tolerance = kEpsilon,
+               ExecutionPolicy_ const& execution_policy =
+                   Base_::GetDefaultExecutionPolicy()) const;
 
   Coordinate ComputeUpperBoundForMaximumDistanceFromOrigin() const override;
   OutputInformation_ Write(Precision const& precision = kPrecision) const;
 
+  /// @brief Extracts the Bezier patches of all elements without modifying the
+  /// spline. Control points of element e are stored contiguously in rows
+  /// [e * n, (e + 1) * n) with n = prod(p_i + 1). Elements as well as control
+  /// points within an element are ordered with the first dimension running
+  /// fastest, i.e., the same way as the spline's coordinates.
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @param tolerance
+  /// @return control points of Bezier patches and their parametric bounds
+  BezierPatches_
+  ExtractBezierPatches(ExecutionPolicy_ const& execution_policy = {},
+                       Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Lets EvaluateBatch read the control points of an element from a
+  /// packed copy of the coordinates, in which the prod(p_i + 1) control points
+  /// of each non-zero element are stored contiguously, instead of gathering
+  /// them from the whole control net.  Single evaluations are not affected.
+  /// The copy is built on first use and rebuilt once the coordinates or knots
+  /// change (see VectorSpace::GetRevision), e.g., due to a refinement.  It
+  /// takes up to prod(p_i + 1) times the memory of the coordinates and is
+  /// released when disabled.
+  /// @param use
+  void UsePackedElementCoordinates(bool const& use);
+  /// @brief
+  /// @return whether evaluations read packed element coordinates
+  bool const& IsUsingPackedElementCoordinates() const {
+    return use_packed_element_coordinates_;
+  }
+
   /// @brief
   /// @param from
   /// @param to
@@ -126,6 +268,9 @@ public:
   };
 
 protected:
+  template<int, int, int, int...>
+  friend class StaticBSpline;
+
   SharedPointer<VectorSpace_> vector_space_;
 
 private:
@@ -136,11 +281,92 @@ private:
   using IndexValue_ = typename Index_::Value_;
   using KnotRatios_ = typename ParameterSpace_::KnotRatios_;
   using Knots_ = typename Base_::Knots_;
+  using KnotSpans_ = typename ParameterSpace_::KnotSpans_;
+  using StridedIndex_ = typename ParameterSpace_::StridedIndex_;
   using BinomialRatio_ = typename BinomialRatios_::value_type;
   using KnotRatio_ = typename KnotRatios_::value_type;
+  template<typename T>
+  using TemporaryData_ = bsplinelib::utilities::containers::TemporaryData<T>;
+
+  using BasisValuesPerDimension_ =
+      typename ParameterSpace_::BasisValuesPerDimension_;
+
+  // Combine accumulates on the stack up to this dimension, on the heap above.
+  static constexpr int kStackDimension_{4};
+
+  // Coordinates with the control points of each non-zero element stored
+  // contiguously as array of structures, i.e., prod(e_i) blocks of
+  // prod(p_i + 1) control points for e_i elements in dimension i, both ordered
+  // with the first dimension running fastest.  Elements are looked up by their
+  // first non-zero basis function, so repeated knots do not add blocks.
+  struct PackedElementCoordinates_ {
+    typename VectorSpace_::Revision_ revision_;
+    Array<parameter_spaces::KnotVector::Revision_, para_dim> knot_revisions_;
+    Index number_of_coordinates_;
+    // element of each first non-zero basis function, -1 for empty knot spans
+    Array<Vector<Index>, para_dim> elements_;
+    typename StridedIndex_::Stride_ element_strides_;
+    Index block_size_;
+    Coordinates_ coordinates_;
+  };
+
+  // Cached packed element coordinates.  Copies and moves start with an empty
+  // cache.
+  struct PackedElementCoordinatesCache_ {
+    PackedElementCoordinatesCache_() = default;
+    PackedElementCoordinatesCache_(PackedElementCoordinatesCache_ const&) {}
+    PackedElementCoordinatesCache_(PackedElementCoordinatesCache_&&) noexcept {}
+    PackedElementCoordinatesCache_&
+    operator=(PackedElementCoordinatesCache_ const&) {
+      packed_.reset();
+      return *this;
+    }
+    PackedElementCoordinatesCache_&
+    operator=(PackedElementCoordinatesCache_&&) noexcept {
+      packed_.reset();
+      return *this;
+    }
+
+    std::mutex mutex_;
+    SharedPointer<PackedElementCoordinates_ const> packed_;
+  };
+
+  bool use_packed_element_coordinates_{false};
+  mutable PackedElementCoordinatesCache_ packed_element_coordinates_cache_;
 
   BezierInformation_ MakeBezier(Dimension const& dimension,
                                 Tolerance const& tolerance = kEpsilon) const;
+
+  // Accumulates the control points weighted by the tensor product of given
+  // basis values, evaluated on given effective knot spans, into evaluated.
+  // Reads the control points from packed if given.
+  void Combine(BasisValuesPerDimension_ const& basis_values_per_dimension,
+               KnotSpans_ const& effective_knot_spans,
+               Coordinate_& evaluated,
+               PackedElementCoordinates_ const* packed = nullptr) const;
+
+  // Packed element coordinates of the current coordinates, (re)built if
+  // needed.  Thread-safe, but meant to be called once per batch of
+  // evaluations whose Combine calls then read through a plain pointer.
+  SharedPointer<PackedElementCoordinates_ const>
+  GetPackedElementCoordinates() const;
+
+  // Throws if a field does not provide one coordinate per basis function.
+  void ThrowIfFieldsAreIncompatible(Fields_ const& fields) const;
+
+  // Rebuilds the coordinates of this spline and all fields by applying
+  // line_operation(line, new_line, workspace, dim) to each line of
+  // coordinates along given dimension.  Lines are gathered into contiguous
+  // buffers and processed in parallel according to the execution policy.
+  // Coordinates are only replaced if line_operation returned true for all
+  // lines.
+  template<typename LineOperation>
+  bool TransformLines(Fields_ const& fields,
+                      Dimension const& dimension,
+                      IndexLength_ const& number_of_coordinates,
+                      Index const& new_length,
+                      LineOperation const& line_operation,
+                      ExecutionPolicy_ const& execution_policy) const;
 };
 
 #include "BSplineLib/Splines/b_spline.inl"
@@ -30,9 +30,9 @@ BSpline<para_dim>::BSpline(SharedPointer<ParameterSpace_> parameter_space,
   using std::to_string;
 
 #ifndef NDEBUG
-  int const &total_number_of_basis_functions =
-                Base_::parameter_space_->GetTotalNumberOfBasisFunctions(),
-            &number_of_coordinates = vector_space->GetNumberOfCoordinates();
+  Index const &total_number_of_basis_functions =
+                  Base_::parameter_space_->GetTotalNumberOfBasisFunctions(),
+              &number_of_coordinates = vector_space->GetNumberOfCoordinates();
   if (number_of_coordinates != total_number_of_basis_functions)
     Throw(DomainError(to_string(number_of_coordinates)
                       + " coordinates were provided but "
@@ -47,12 +47,16 @@ BSpline<para_dim>::BSpline(SharedPointer<ParameterSpace_> parameter_space,
 template<int para_dim>
 BSpline<para_dim>::BSpline(BSpline const& other)
     : Base_(other),
-      vector_space_{std::make_shared<VectorSpace_>(*other.vector_space_)} {}
+      vector_space_{std::make_shared<VectorSpace_>(*other.vector_space_)},
+      use_packed_element_coordinates_{
+          other.use_packed_element_coordinates_} {}
 
 template<int para_dim>
 BSpline<para_dim>& BSpline<para_dim>::operator=(BSpline const& rhs) {
   Base_::operator=(rhs),
   vector_space_ = std::make_shared<VectorSpace_>(*rhs.vector_space_);
+  use_packed_element_coordinates_ = rhs.use_packed_element_coordinates_;
+  packed_element_coordinates_cache_ = rhs.packed_element_coordinates_cache_;
   return *this;
 }
 
@@ -69,18 +73,12 @@ void BSpline<para_dim>::Evaluate(const Type_* parametric_coordinate,
   // zero initialization is necessary
   evaluated_b_spline.Fill(0.);
 
-  const auto basis_per_dim =
-      parameter_space.EvaluateBasisValuesPerDimension(parametric_coordinate);
-  auto beginning =
-      parameter_space.FindFirstNonZeroBasisFunction(parametric_coordinate);
-  auto offset = parameter_space.First();
-
-  bsplinelib::parameter_spaces::RecursiveCombine(
-      basis_per_dim,
-      beginning,
-      offset,
-      vector_space_->GetCoordinates(),
-      evaluated_b_spline);
+  KnotSpans_ const effective_knot_spans =
+      parameter_space.FindEffectiveKnotSpans(parametric_coordinate);
+  Combine(parameter_space.EvaluateBasisValuesPerDimension(parametric_coordinate,
+                                                          effective_knot_spans),
+          effective_knot_spans,
+          evaluated_b_spline);
 }
 
 template<int para_dim>
@@ -95,20 +93,60 @@ void BSpline<para_dim>::EvaluateDerivative(const Type_* parametric_coordinate,
   // zero initialization is necessary
   evaluated_b_spline_derivative.Fill(0.);
 
-  const auto basis_derivative_per_dim =
-      parameter_space.EvaluateBasisDerivativeValuesPerDimension(
-          parametric_coordinate,
-          derivative);
-  auto beginning =
-      parameter_space.FindFirstNonZeroBasisFunction(parametric_coordinate);
-  auto offset = parameter_space.First();
-
-  bsplinelib::parameter_spaces::RecursiveCombine(
-      basis_derivative_per_dim,
-      beginning,
-      offset,
-      vector_space_->GetCoordinates(),
-      evaluated_b_spline_derivative);
+  Combine(parameter_space.EvaluateBasisDerivativeValuesPerDimension(
+              parametric_coordinate,
+              derivative),
+          parameter_space.FindEffectiveKnotSpans(parametric_coordinate),
+          evaluated_b_spline_derivative);
+}
+
+template<int para_dim>
+void BSpline<para_dim>::EvaluateBatch(
+    const Type_* parametric_coordinates,
+    Index const& number_of_parametric_coordinates,
+    Type_* evaluated,
+    ExecutionPolicy_ const& execution_policy,
+    bool const& order_by_element) const {
+  ParameterSpace_ const& parameter_space = *Base_::parameter_space_;
+  const int dim = vector_space_->Dim();
+  typename ParameterSpace_::EvaluationOrder_ evaluation_order;
+  if (order_by_element) {
+    evaluation_order = parameter_space.DetermineEvaluationOrder(
+        parametric_coordinates,
+        number_of_parametric_coordinates);
+  }
+  auto const& [order, ordered_knot_spans] = evaluation_order;
+
+  // resolved once, evaluations read the packed coordinates without locking
+  SharedPointer<PackedElementCoordinates_ const> const packed{
+      use_packed_element_coordinates_ ? GetPackedElementCoordinates()
+                                      : nullptr};
+
+  auto evaluate = [&](Index const& begin, Index const& end) {
+    Coordinate_ evaluated_b_spline;
+    evaluated_b_spline.SetShape(dim);
+    for (Index k{begin}; k < end; ++k) {
+      const Index j = order_by_element ? order[k] : k;
+      const Type_* parametric_coordinate =
+          parametric_coordinates + j * para_dim;
+      KnotSpans_ const effective_knot_spans =
+          order_by_element
+              ? ordered_knot_spans[k]
+              : parameter_space.FindEffectiveKnotSpans(parametric_coordinate);
+      evaluated_b_spline.SetData(evaluated + j * dim);
+      evaluated_b_spline.Fill(0.);
+      Combine(parameter_space.EvaluateBasisValuesPerDimension(
+                  parametric_coordinate,
+                  effective_knot_spans),
+              effective_knot_spans,
+              evaluated_b_spline,
+              packed.get());
+    }
+  };
+  utilities::parallel_operations::NThreadExecution(
+      evaluate,
+      number_of_parametric_coordinates,
+      execution_policy);
 }
 
 template<int para_dim>
@@ -134,96 +172,118 @@ BSpline<para_dim>::operator()(const Type_* parametric_coordinate,
   return evaluated_b_spline_derivative;
 }
 
-// Cf. NURBS book Eq. (5.15).
 template<int para_dim>
 void BSpline<para_dim>::InsertKnot(Dimension const& dimension,
                                    Knot_ knot,
                                    Multiplicity const& multiplicity,
-                                   Tolerance const& tolerance) const {
-  using utilities::containers::Add, utilities::containers::Multiply;
+                                   Tolerance const& tolerance,
+                                   ExecutionPolicy_ const& execution_policy)
+    const {
+  InsertKnot(Fields_{},
+             dimension,
+             knot,
+             multiplicity,
+             tolerance,
+             execution_policy);
+}
+
+// Cf. NURBS book A5.1.  Lines of coordinates along the dimension are
+// independent of each other and rebuilt in parallel.
+template<int para_dim>
+void BSpline<para_dim>::InsertKnot(Fields_ const& fields,
+                                   Dimension const& dimension,
+                                   Knot_ knot,
+                                   Multiplicity const& multiplicity,
+                                   Tolerance const& tolerance,
+                                   ExecutionPolicy_ const& execution_policy)
+    const {
+  ThrowIfFieldsAreIncompatible(fields);
 
   // bound checks are all done in parametric space
   ParameterSpace_& parameter_space = *Base_::parameter_space_;
-  VectorSpace_& vector_space = *vector_space_;
 
   // collect values before updating parameter_space
-  const int n_original_coord = vector_space.GetNumberOfCoordinates();
-  IndexLength_ number_of_coordinates{
+  IndexLength_ const number_of_coordinates{
       parameter_space.GetNumberOfBasisFunctions()};
-  const int n_total_original_coords =
-      parameter_space.GetTotalNumberOfBasisFunctions();
-  const int n_coords_per_slice =
-      n_total_original_coords / number_of_coordinates[dimension];
-
   auto const& [start_value, coefficients] =
       parameter_space.InsertKnot(dimension, knot, multiplicity, tolerance);
-  // TODO(all): use std::for_each once clang supports capturing of variables
-  // from structured bindings
-  const int n_new_points = coefficients.size() * n_coords_per_slice;
-  vector_space.AppendEmptyCoordinates(n_new_points);
-  int ignore_from{};
-  for (KnotRatios_ const& current_coefficients : coefficients) {
-    IndexLength_ number_of_coordinates_in_slice{number_of_coordinates};
-    number_of_coordinates_in_slice[dimension] = Length{};
-    IndexLength_ const previous_number_of_coordinates{number_of_coordinates};
-    ++number_of_coordinates[dimension];
-    for (Index_ slice_coordinate{Index_::First(number_of_coordinates_in_slice)};
-         slice_coordinate != Index_::Behind(number_of_coordinates_in_slice);
-         ++slice_coordinate) {
-      constexpr KnotRatio_ const k1_0{1.0};
-
-      IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-      coordinate_value[dimension] = start_value;
-      Index_ coordinate{number_of_coordinates, coordinate_value};
-      Index const insertion_position = coordinate.GetIndex1d();
-      // C^0 to C^-1 insertion, second case does not apply (insert repetition)
-      if (current_coefficients.empty()) {
-        // we need to pass copy to this
-        vector_space.StaticInsert(
-            insertion_position,
-            vector_space[Index_::GetIndex1d(previous_number_of_coordinates,
-                                            coordinate_value)
-                         + slice_coordinate.GetIndex1d()]
-                .Copy(),
-            n_total_original_coords + ignore_from++);
-        continue;
-      }
-
-      typename KnotRatios_::const_reverse_iterator coefficient{
-          current_coefficients.rbegin()};
-      vector_space.StaticInsert(
-          insertion_position,
-          Add(Multiply(vector_space[Index_::GetIndex1d(
-                                        previous_number_of_coordinates,
-                                        coordinate_value)
-                                    + slice_coordinate.GetIndex1d()],
-                       *coefficient),
-              Multiply(
-                  vector_space[coordinate.Decrement(dimension).GetIndex1d()],
-                  k1_0 - *coefficient)),
-          n_total_original_coords + ignore_from++);
-      ++coefficient;
-      for (; coefficient < current_coefficients.rend(); ++coefficient) {
-        Index const& replacement_position = coordinate.GetIndex1d();
-        vector_space.Replace(
-            replacement_position,
-            Add(Multiply(vector_space[replacement_position], *coefficient),
-                Multiply(
-                    vector_space[coordinate.Decrement(dimension).GetIndex1d()],
-                    k1_0 - *coefficient)));
-      }
-    }
+  const int number_of_insertions = static_cast<int>(coefficients.size());
+  if (number_of_insertions == 0) {
+    return;
   }
+
+  const int length = number_of_coordinates[dimension];
+  // first insertion affects coordinates [k-p, k-s], i.e., p-s+1 coordinates
+  const int number_of_affected = static_cast<int>(coefficients[0].size()) + 1;
+  const int first_affected = start_value - number_of_affected + 1;
+  const int shifted_start = start_value + number_of_insertions;
+
+  TransformLines(
+      fields,
+      dimension,
+      number_of_coordinates,
+      length + number_of_insertions,
+      [&](const Type_* line,
+          Type_* new_line,
+          Type_* affected,
+          int const& dim) {
+        constexpr KnotRatio_ const k1_0{1.0};
+
+        // unaffected coordinates are copied
+        std::copy_n(line, (first_affected + 1) * dim, new_line);
+        std::copy_n(line + start_value * dim,
+                    (length - start_value) * dim,
+                    new_line + shifted_start * dim);
+        std::copy_n(line + first_affected * dim,
+                    number_of_affected * dim,
+                    affected);
+
+        int lower_position{first_affected};
+        for (int j{1}; j <= number_of_insertions; ++j) {
+          KnotRatios_ const& current_coefficients = coefficients[j - 1];
+          const int number_of_coefficients =
+              static_cast<int>(current_coefficients.size());
+          for (int i{}; i < number_of_coefficients; ++i) {
+            KnotRatio_ const& coefficient = current_coefficients[i];
+            Type_* current_lower = affected + i * dim;
+            utilities::containers::Axpby(coefficient,
+                                         current_lower + dim,
+                                         k1_0 - coefficient,
+                                         current_lower,
+                                         dim,
+                                         current_lower);
+          }
+          lower_position = first_affected + j;
+          std::copy_n(affected, dim, new_line + lower_position * dim);
+          // C^0 to C^-1 insertion only repeats the coordinate
+          if (number_of_coefficients > 0) {
+            std::copy_n(affected + (number_of_coefficients - 1) * dim,
+                        dim,
+                        new_line + (shifted_start - j) * dim);
+          }
+        }
+        for (int i{lower_position + 1}; i < start_value; ++i) {
+          std::copy_n(affected + (i - lower_position) * dim,
+                      dim,
+                      new_line + i * dim);
+        }
+        return true;
+      },
+      execution_policy);
 }
 
+// Inverts knot insertion Q_i = c_i P_i + (1 - c_i) P_{i-1} from the left,
+// i.e., P_i = (Q_i - (1 - c_i) P_{i-1}) / c_i, one removal at a time.  The
+// last equation must be satisfied within tolerance_removal on all lines.
 template<int para_dim>
 Multiplicity BSpline<para_dim>::RemoveKnot(Dimension const& dimension,
                                            Knot_ const& knot,
                                            Tolerance const& tolerance_removal,
                                            Multiplicity const& multiplicity,
-                                           Tolerance const& tolerance) const {
-  using utilities::containers::Divide, utilities::containers::Multiply,
-      utilities::containers::Subtract;
+                                           Tolerance const& tolerance,
+                                           ExecutionPolicy_ const&
+                                               execution_policy) const {
+  using utilities::containers::Axpby, utilities::containers::SquaredDistance;
 
   // bound checks are all done in parametric space
   ParameterSpace_& parameter_space = *Base_::parameter_space_;
@@ -234,284 +294,302 @@ Multiplicity BSpline<para_dim>::RemoveKnot(Dimension const& dimension,
   auto const& [start_value, coefficients] =
       parameter_space.RemoveKnot(dimension, knot, multiplicity, tolerance);
   Multiplicity const& removals = coefficients.size();
+  const Type_ squared_tolerance = tolerance_removal * tolerance_removal;
   for (Multiplicity removal{removals}; removal > Multiplicity{}; --removal) {
-    VectorSpace_& vector_space = *vector_space_;
-    VectorSpace_ const vector_space_backup{vector_space};
+    constexpr KnotRatio_ const k1_0{1.0};
+
     KnotRatios_ const& current_coefficients = coefficients[removal - 1];
-    IndexLength_ number_of_coordinates_in_slice{number_of_coordinates};
-    number_of_coordinates_in_slice[dimension] = Length{};
-    IndexLength_ const previous_number_of_coordinates{number_of_coordinates};
-    --number_of_coordinates[dimension];
-    for (Index_ slice_coordinate{Index_::Last(number_of_coordinates_in_slice)};
-         slice_coordinate != Index_::Before(number_of_coordinates_in_slice);
-         --slice_coordinate) {
-      constexpr KnotRatio_ const k1_0{1.0};
-
-      IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-      coordinate_value[dimension] =
-          (start_value
-           - Index{static_cast<Index>(current_coefficients.size())});
-      Index_ coordinate{previous_number_of_coordinates, coordinate_value};
-      Index coordinate_index{coordinate.GetIndex1d()}, lower_coordinate_index;
-      typename KnotRatios_::const_iterator coefficient{
-          current_coefficients.begin()};
-      for (; coefficient != std::prev(current_coefficients.end());
-           ++coefficient) {
-        KnotRatio_ const& current_coefficient = *coefficient;
-        lower_coordinate_index = coordinate_index;
-        coordinate_index = coordinate.Increment(dimension).GetIndex1d();
-        vector_space.Replace(
-            coordinate_index,
-            Divide(Subtract(vector_space[coordinate_index],
-                            Multiply(vector_space[lower_coordinate_index],
-                                     k1_0 - current_coefficient)),
-                   current_coefficient));
-      }
-      KnotRatio_ const& current_coefficient = *coefficient;
-      lower_coordinate_index = coordinate_index;
-      coordinate_index = coordinate.Increment(dimension).GetIndex1d();
-      if ( // IsLessOrEqual(
-          utilities::containers::EuclidianDistance(
-              Divide(Subtract(vector_space[coordinate_index],
-                              Multiply(vector_space[lower_coordinate_index],
-                                       k1_0 - current_coefficient)),
-                     current_coefficient),
-              vector_space[Index_{number_of_coordinates, coordinate.GetIndex()}
-                               .GetIndex1d()
-                           + slice_coordinate.GetIndex1d() + Index{1}])
-          <= tolerance_removal) {
-        vector_space.Erase(coordinate_index);
-      } else {
-        Multiplicity const& successful_removals = (multiplicity - removal);
-        parameter_space_backup.RemoveKnot(dimension,
-                                          knot,
-                                          successful_removals,
-                                          tolerance);
-        parameter_space = parameter_space_backup;
-        vector_space = vector_space_backup;
-        return successful_removals;
-      }
+    const int number_of_coefficients =
+        static_cast<int>(current_coefficients.size());
+    const int length = number_of_coordinates[dimension];
+    // coordinates up to first are not affected
+    const int first = start_value - number_of_coefficients;
+
+    const bool successful = TransformLines(
+        Fields_{},
+        dimension,
+        number_of_coordinates,
+        length - 1,
+        [&](const Type_* line,
+            Type_* new_line,
+            Type_* candidate,
+            int const& dim) {
+          std::copy_n(line, (first + 1) * dim, new_line);
+          for (int i{}; i < number_of_coefficients; ++i) {
+            KnotRatio_ const& coefficient = current_coefficients[i];
+            const int position = first + 1 + i;
+            // the last equation yields the candidate for the removed one
+            Type_* solution = (i + 1 < number_of_coefficients)
+                                  ? new_line + position * dim
+                                  : candidate;
+            Axpby(k1_0 / coefficient,
+                  line + position * dim,
+                  -(k1_0 - coefficient) / coefficient,
+                  new_line + (position - 1) * dim,
+                  dim,
+                  solution);
+          }
+          // C^-1 to C^0 removal only drops a repeated coordinate
+          if (number_of_coefficients == 0) {
+            std::copy_n(line + first * dim, dim, candidate);
+          }
+          const int removed = first + number_of_coefficients + 1;
+          if (SquaredDistance(candidate, line + removed * dim, dim)
+              > squared_tolerance) {
+            return false;
+          }
+          std::copy_n(line + removed * dim,
+                      (length - removed) * dim,
+                      new_line + (removed - 1) * dim);
+          return true;
+        },
+        execution_policy);
+
+    if (!successful) {
+      Multiplicity const& successful_removals = removals - removal;
+      parameter_space_backup.RemoveKnot(dimension,
+                                        knot,
+                                        successful_removals,
+                                        tolerance);
+      parameter_space = parameter_space_backup;
+      return successful_removals;
     }
+    --number_of_coordinates[dimension];
   }
   return Multiplicity{removals};
 }
 
-// Cf. NURBS book Eq. (5.36).
+// Cf. NURBS book Eq. (5.36).  Lines of coordinates along the dimension are
+// independent of each other and rebuilt in parallel.
 template<int para_dim>
 void BSpline<para_dim>::ElevateDegree(Dimension const& dimension,
                                       Multiplicity const& multiplicity,
-                                      Tolerance const& tolerance) const {
-  using utilities::containers::AddAndAssignToFirst,
-      utilities::containers::GetBack, utilities::containers::Multiply;
-
+                                      Tolerance const& tolerance,
+                                      ExecutionPolicy_ const& execution_policy)
+    const {
   // bound checks are all done in parametric space
   ParameterSpace_& parameter_space = *Base_::parameter_space_;
-  VectorSpace_& vector_space = *vector_space_;
 
   // collect values before updating parameter_space
   auto const& [number_of_segments, knots_inserted] =
       MakeBezier(dimension, tolerance);
-  IndexLength_ number_of_coordinates{
+  IndexLength_ const number_of_coordinates{
       parameter_space.GetNumberOfBasisFunctions()};
-  const int n_total_original_coords =
-      parameter_space.GetTotalNumberOfBasisFunctions();
-  const int n_coords_per_slice =
-      n_total_original_coords / number_of_coordinates[dimension];
 
-  // update parameter space and prepare loops
-  auto const& [last_segment_coordinate, coefficients] =
+  // update parameter space
+  auto const& [degree, coefficients] =
       parameter_space.ElevateDegree(dimension, multiplicity);
-  IndexLength_ number_of_coordinates_in_slice{number_of_coordinates};
-  number_of_coordinates_in_slice[dimension] = Length{};
-  Index const maximum_interior_coordinate{
-      static_cast<int>(coefficients.size() - 1)};
-  int ignore_from{};
-  vector_space.AppendEmptyCoordinates(
-      n_coords_per_slice * number_of_segments
-      * (maximum_interior_coordinate - (last_segment_coordinate - 1) + 1));
-  for (int segment{}; segment < number_of_segments; ++segment) {
-    int interior_coordinate{maximum_interior_coordinate},
-        last_coordinate{((segment + 1) * last_segment_coordinate)
-                        + (segment * multiplicity)};
-    for (; interior_coordinate >= (last_segment_coordinate - 1);
-         --interior_coordinate) {
-      BinomialRatios_ const& current_coefficients =
-          coefficients[interior_coordinate];
-      IndexLength_ const previous_number_of_coordinates{number_of_coordinates};
-      ++number_of_coordinates[dimension];
-      for (Index_ slice_coordinate{
-               Index_::First(number_of_coordinates_in_slice)};
-           slice_coordinate != Index_::Behind(number_of_coordinates_in_slice);
-           ++slice_coordinate) {
-        IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-        coordinate_value[dimension] = last_coordinate;
-        Index_ current_coordinate{number_of_coordinates, coordinate_value};
-        Index const& insertion_position = current_coordinate.GetIndex1d();
-        IndexValue_ current_last_coordinate_value{coordinate_value};
-        current_last_coordinate_value[dimension] +=
-            (maximum_interior_coordinate - interior_coordinate);
-        Coordinate_ coordinate{
-            Multiply(vector_space[Index_{previous_number_of_coordinates,
-                                         current_last_coordinate_value}
-                                      .GetIndex1d()
-                                  + slice_coordinate.GetIndex1d()],
-                     GetBack(current_coefficients))};
-        std::for_each(
-            current_coefficients.rbegin() + 1,
-            current_coefficients.rend(),
-            [&](BinomialRatio_ const& coefficient) {
-              AddAndAssignToFirst(
-                  coordinate,
-                  Multiply(vector_space[current_coordinate.Decrement(dimension)
-                                            .GetIndex1d()],
-                           coefficient));
-            });
-        vector_space.StaticInsert(insertion_position,
-                                  coordinate,
-                                  n_total_original_coords + ignore_from++);
-      }
-    }
+  const int elevated_degree = degree + multiplicity;
 
-    for (; interior_coordinate >= Index{}; --interior_coordinate) {
-      BinomialRatios_ const& current_coefficients =
-          coefficients[interior_coordinate];
-      --last_coordinate;
-      for (Index_ slice_coordinate{
-               Index_::First(number_of_coordinates_in_slice)};
-           slice_coordinate != Index_::Behind(number_of_coordinates_in_slice);
-           ++slice_coordinate) {
-        IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-        coordinate_value[dimension] = last_coordinate;
-        Index_ current_coordinate{number_of_coordinates, coordinate_value};
-        Index const& replacement_position = current_coordinate.GetIndex1d();
-        Coordinate_ coordinate{Multiply(vector_space[replacement_position],
-                                        GetBack(current_coefficients))};
-        std::for_each(
-            current_coefficients.rbegin() + 1,
-            current_coefficients.rend(),
-            [&](BinomialRatio_ const& coefficient) {
-              AddAndAssignToFirst(
-                  coordinate,
-                  Multiply(vector_space[current_coordinate.Decrement(dimension)
-                                            .GetIndex1d()],
-                           coefficient));
-            });
-        vector_space.Replace(replacement_position, coordinate);
-      }
-    }
-  }
+  TransformLines(
+      Fields_{},
+      dimension,
+      number_of_coordinates,
+      number_of_segments * elevated_degree + 1,
+      [&](const Type_* line, Type_* new_line, Type_*, int const& dim) {
+        for (int segment{}; segment < number_of_segments; ++segment) {
+          const Type_* bezier = line + segment * degree * dim;
+          Type_* elevated = new_line + segment * elevated_degree * dim;
+          std::copy_n(bezier, dim, elevated);
+          for (int i{1}; i < elevated_degree; ++i) {
+            BinomialRatios_ const& current_coefficients = coefficients[i - 1];
+            const Type_* current_bezier =
+                bezier + std::max(0, i - multiplicity) * dim;
+            Type_* current_elevated = elevated + i * dim;
+            for (int j{}; j < dim; ++j) {
+              Accumulation sum{};
+              const Type_* coordinate = current_bezier + j;
+              for (BinomialRatio_ const& coefficient : current_coefficients) {
+                sum += static_cast<Accumulation>(coefficient) * *coordinate;
+                coordinate += dim;
+              }
+              current_elevated[j] = static_cast<Type_>(sum);
+            }
+          }
+        }
+        std::copy_n(line + number_of_segments * degree * dim,
+                    dim,
+                    new_line + number_of_segments * elevated_degree * dim);
+        return true;
+      },
+      execution_policy);
   Base_::CoarsenKnots(dimension, knots_inserted, tolerance);
 }
 
+// Unlike ElevateDegree(dimension, ...), there is no intermediate Bezier
+// decomposition and subsequent knot removal, which would have to be repeated
+// for each field.
+template<int para_dim>
+void BSpline<para_dim>::ElevateDegree(Fields_ const& fields,
+                                      Dimension const& dimension,
+                                      Multiplicity const& multiplicity,
+                                      Tolerance const& tolerance,
+                                      ExecutionPolicy_ const& execution_policy)
+    const {
+  RefinementPlan_ plan{};
+  plan[dimension].degree_ =
+      Base_::parameter_space_->GetDegree(dimension) + multiplicity;
+  Refine(fields, plan, tolerance, execution_policy);
+}
+
+// Inverts Eq. (5.36) of the NURBS book.  The first p-t Bezier coordinates of
+// each segment follow from the first equations, the remaining equations must
+// be satisfied within tolerance_reduction for the reduction to be exact.
 template<int para_dim>
 bool BSpline<para_dim>::ReduceDegree(Dimension const& dimension,
                                      Tolerance const& tolerance_reduction,
                                      Multiplicity const& multiplicity,
-                                     Tolerance const& tolerance) const {
-  using std::for_each, utilities::containers::GetBack,
-      utilities::containers::Multiply,
-      utilities::containers::SubtractAndAssignToFirst;
+                                     Tolerance const& tolerance,
+                                     ExecutionPolicy_ const& execution_policy)
+    const {
+  using utilities::containers::SquaredDistance;
 
   // bound checks are all done in parametric space
   ParameterSpace_& parameter_space = *Base_::parameter_space_;
   ParameterSpace_ parameter_space_backup{parameter_space};
-  VectorSpace_& vector_space = *vector_space_;
-  VectorSpace_ vector_space_backup{vector_space};
+  Coordinates_ coordinates_backup{
+      std::as_const(*vector_space_).GetCoordinates()};
+
   auto const& [number_of_segments, knots_inserted] =
       MakeBezier(dimension, tolerance);
-  IndexLength_ number_of_coordinates{
+  IndexLength_ const number_of_coordinates{
       parameter_space.GetNumberOfBasisFunctions()};
-  auto const& [last_segment_coordinate, coefficients] =
+  const int degree = parameter_space.GetDegree(dimension);
+  auto const& [reduced_degree, coefficients] =
       parameter_space.ReduceDegree(dimension, multiplicity);
-  Degree const& elevatetd_degree = (coefficients.size() + 1);
-  IndexLength_ number_of_coordinates_in_slice{number_of_coordinates};
-  number_of_coordinates_in_slice[dimension] = Length{};
-  for (int segment{number_of_segments - 1}; segment >= 0; --segment) {
-    Index interior_coordinate{},
-        coordinate_index{1 + (segment * elevatetd_degree)};
-    for (; interior_coordinate < (last_segment_coordinate - Index{1});
-         ++interior_coordinate) {
-      BinomialRatios_ const& current_coefficients =
-          coefficients[interior_coordinate];
-      for (Index_ slice_coordinate{
-               Index_::Last(number_of_coordinates_in_slice)};
-           slice_coordinate != Index_::Before(number_of_coordinates_in_slice);
-           --slice_coordinate) {
-        IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-        coordinate_value[dimension] = coordinate_index;
-        Index_ current_coordinate{number_of_coordinates, coordinate_value};
-        Index const& replacement_position = current_coordinate.GetIndex1d();
-        Coordinate_ coordinate{vector_space[replacement_position]};
-        for_each(
-            current_coefficients.begin(),
-            std::prev(current_coefficients.end()),
-            [&](BinomialRatio_ const& coefficient) {
-              SubtractAndAssignToFirst(
-                  coordinate,
-                  Multiply(vector_space[current_coordinate.Decrement(dimension)
-                                            .GetIndex1d()],
-                           coefficient));
-            });
-        vector_space.Replace(
-            replacement_position,
-            utilities::containers::Divide(coordinate,
-                                          GetBack(current_coefficients)));
+  const int reduction = degree - reduced_degree;
+  const int dim = vector_space_->Dim();
+  const Type_ squared_tolerance = tolerance_reduction * tolerance_reduction;
+
+  // Q_i = (P_i - sum_{j < i} c_ij Q_j) / c_ii with i the last used j
+  auto const solve = [&](int const& i,
+                         const Type_* bezier,
+                         const Type_* reduced,
+                         Type_* solution) {
+    BinomialRatios_ const& current_coefficients = coefficients[i - 1];
+    const Type_* current_reduced =
+        reduced + std::max(0, i - reduction) * dim;
+    for (int j{}; j < dim; ++j) {
+      Accumulation sum{bezier[i * dim + j]};
+      const Type_* coordinate = current_reduced + j;
+      for (auto coefficient{current_coefficients.begin()};
+           coefficient != std::prev(current_coefficients.end());
+           ++coefficient) {
+        sum -= static_cast<Accumulation>(*coefficient) * *coordinate;
+        coordinate += dim;
       }
-      ++coordinate_index;
+      solution[j] = static_cast<Type_>(sum / current_coefficients.back());
     }
-    Index const maximum_interior_coordinate{elevatetd_degree - 2};
-    for (; interior_coordinate <= maximum_interior_coordinate;
-         ++interior_coordinate) {
-      BinomialRatios_ const& current_coefficients =
-          coefficients[interior_coordinate];
-      IndexLength_ const previous_number_of_coordinates{number_of_coordinates};
-      --number_of_coordinates[dimension];
-      for (Index_ slice_coordinate{
-               Index_::Last(number_of_coordinates_in_slice)};
-           slice_coordinate != Index_::Before(number_of_coordinates_in_slice);
-           --slice_coordinate) {
-        IndexValue_ coordinate_value{slice_coordinate.GetIndex()};
-        coordinate_value[dimension] = coordinate_index;
-        Index_ current_coordinate{previous_number_of_coordinates,
-                                  coordinate_value};
-        Index const& erasure_position = current_coordinate.GetIndex1d();
-        IndexValue_ current_last_coordinate_value{coordinate_value};
-        current_last_coordinate_value[dimension] +=
-            (maximum_interior_coordinate - interior_coordinate);
-        Coordinate_ coordinate{vector_space[erasure_position]};
-        for_each(
-            current_coefficients.rbegin() + 1,
-            current_coefficients.rend(),
-            [&](BinomialRatio_ const& coefficient) {
-              SubtractAndAssignToFirst(
-                  coordinate,
-                  Multiply(vector_space[current_coordinate.Decrement(dimension)
-                                            .GetIndex1d()],
-                           coefficient));
-            });
-        if ( // IsLessOrEqual(
-            utilities::containers::EuclidianDistance(
-                utilities::containers::DivideAndAssignToFirst(
-                    coordinate,
-                    GetBack(current_coefficients)),
-                vector_space[Index_{number_of_coordinates,
-                                    current_last_coordinate_value}
-                                 .GetIndex1d()
-                             + slice_coordinate.GetIndex1d() + Index{1}])
-            <= tolerance_reduction) {
-          vector_space.Erase(erasure_position);
-        } else {
-          parameter_space = parameter_space_backup;
-          vector_space = vector_space_backup;
-          return false;
+  };
+
+  const bool successful = TransformLines(
+      Fields_{},
+      dimension,
+      number_of_coordinates,
+      number_of_segments * reduced_degree + 1,
+      [&](const Type_* line, Type_* new_line, Type_* solution, int const&) {
+        for (int segment{}; segment < number_of_segments; ++segment) {
+          const Type_* bezier = line + segment * degree * dim;
+          Type_* reduced = new_line + segment * reduced_degree * dim;
+          std::copy_n(bezier, dim, reduced);
+          for (int i{1}; i < reduced_degree; ++i) {
+            solve(i, bezier, reduced, reduced + i * dim);
+          }
+          const Type_* last = bezier + degree * dim;
+          std::copy_n(last, dim, reduced + reduced_degree * dim);
+          for (int i{reduced_degree}; i < degree; ++i) {
+            solve(i, bezier, reduced, solution);
+            if (SquaredDistance(solution, last, dim) > squared_tolerance) {
+              return false;
+            }
+          }
         }
-      }
-    }
+        return true;
+      },
+      execution_policy);
+
+  if (!successful) {
+    parameter_space = parameter_space_backup;
+    vector_space_->SetCoordinates(std::move(coordinates_backup));
+    return false;
   }
   Base_::CoarsenKnots(dimension, knots_inserted, tolerance);
   return true;
 }
 
+template<int para_dim>
+void BSpline<para_dim>::Refine(RefinementPlan_ const& plan,
+                               Tolerance const& tolerance,
+                               ExecutionPolicy_ const& execution_policy) const {
+  Refine(Fields_{}, plan, tolerance, execution_policy);
+}
+
+template<int para_dim>
+void BSpline<para_dim>::Refine(Fields_ const& fields,
+                               RefinementPlan_ const& plan,
+                               Tolerance const& tolerance,
+                               ExecutionPolicy_ const& execution_policy) const {
+  ThrowIfFieldsAreIncompatible(fields);
+
+  ParameterSpace_& parameter_space = *Base_::parameter_space_;
+  for (int i{}; i < para_dim; ++i) {
+    auto const& refinement = plan[i];
+    if (refinement.knots_.empty()
+        && (refinement.degree_ < 0
+            || refinement.degree_ == parameter_space.GetDegree(i))) {
+      continue;
+    }
+
+    IndexLength_ const number_of_coordinates{
+        parameter_space.GetNumberOfBasisFunctions()};
+    auto const prolongation =
+        parameter_space.Refine(Dimension{i}, refinement, tolerance);
+    TransformLines(
+        fields,
+        Dimension{i},
+        number_of_coordinates,
+        prolongation.number_of_rows_,
+        [&](const Type_* line, Type_* new_line, Type_*, int const& dim) {
+          prolongation.Multiply(line, dim, new_line);
+          return true;
+        },
+        execution_policy);
+  }
+}
+
+template<int para_dim>
+typename BSpline<para_dim>::Split_
+BSpline<para_dim>::Split(Dimension const& dimension,
+                         Knot_ const& knot,
+                         Tolerance const& tolerance,
+                         ExecutionPolicy_ const& execution_policy) const {
+  using vector_spaces::Layout;
+
+  // coordinates are split as array of structures
+  VectorSpace_ const& vector_space = *vector_space_;
+  const Layout& layout = vector_space.GetLayout();
+  Coordinates_ array_of_structures;
+  if (layout != Layout::kArrayOfStructures) {
+    array_of_structures =
+        vector_space.CopyCoordinates(Layout::kArrayOfStructures);
+  }
+  auto sides = Base_::SplitCoordinates(
+      dimension,
+      knot,
+      layout == Layout::kArrayOfStructures ? vector_space.GetCoordinates()
+                                           : array_of_structures,
+      tolerance,
+      execution_policy);
+  Split_ splits;
+  for (int i{}; i < 2; ++i) {
+    auto& [parameter_space, coordinates] = sides[i];
+    splits[i] = std::make_shared<BSpline>(
+        std::move(parameter_space),
+        std::make_shared<VectorSpace_>(std::move(coordinates), layout));
+  }
+  return splits;
+}
+
 template<int para_dim>
 Coordinate
 BSpline<para_dim>::ComputeUpperBoundForMaximumDistanceFromOrigin() const {
@@ -525,6 +603,447 @@ BSpline<para_dim>::Write(Precision const& precision) const {
                             vector_space_->Write(precision)};
 }
 
+// Applies the extraction operators dimension by dimension (sum factorization),
+// i.e., Q_e = (C_e^{para_dim-1} x ... x C_e^0)^T P_e.
+template<int para_dim>
+typename BSpline<para_dim>::BezierPatches_
+BSpline<para_dim>::ExtractBezierPatches(
+    ExecutionPolicy_ const& execution_policy,
+    Tolerance const& tolerance) const {
+  using ExtractionInformation = SharedPointer<
+      typename ParameterSpace_::BezierExtractionInformation_ const>;
+
+  ParameterSpace_ const& parameter_space = *Base_::parameter_space_;
+  VectorSpace_ const& vector_space = *vector_space_;
+  const int dim = vector_space.Dim();
+  const Index coordinate_stride = vector_space.GetCoordinateStride(),
+              component_stride = vector_space.GetComponentStride();
+
+  Array<ExtractionInformation, para_dim> extraction_information;
+  Array<Knot_ const*, para_dim> knots;
+  Array<int, para_dim> number_of_elements, number_of_bezier_points,
+      local_strides;
+  typename StridedIndex_::Stride_ global_strides;
+  int total_number_of_elements{1}, number_of_local_points{1};
+  Index global_stride{1};
+  for (int i{}; i < para_dim; ++i) {
+    extraction_information[i] =
+        parameter_space.GetBezierExtractionOperators(Dimension{i}, tolerance);
+    number_of_elements[i] =
+        static_cast<int>(std::get<0>(*extraction_information[i]).size());
+    number_of_bezier_points[i] = parameter_space.GetDegree(i) + 1;
+    // const access, i.e., cached information of the knot vector is kept
+    knots[i] = parameter_space.GetKnotVector(i)->GetData();
+    global_strides[i] = global_stride;
+    local_strides[i] = number_of_local_points;
+    global_stride *= parameter_space.GetKnotVector(i)->GetSize()
+                     - number_of_bezier_points[i];
+    total_number_of_elements *= number_of_elements[i];
+    number_of_local_points *= number_of_bezier_points[i];
+  }
+
+  BezierPatches_ bezier_patches{
+      Coordinates_(static_cast<Index>(total_number_of_elements)
+                       * number_of_local_points,
+                   dim),
+      ParametricBounds_(total_number_of_elements, 2 * para_dim)};
+  Coordinates_& patches = std::get<0>(bezier_patches);
+  ParametricBounds_& bounds = std::get<1>(bezier_patches);
+  if (total_number_of_elements == 0) {
+    return bezier_patches;
+  }
+  const Type_* coordinates = vector_space.GetCoordinates().data();
+  IndexLength_ const number_of_non_zero_basis_functions =
+      parameter_space.GetNumberOfNonZeroBasisFunctions();
+
+  auto extract = [&](Index const& begin, Index const& end) {
+    TemporaryData_<Type_> first_buffer(number_of_local_points * dim),
+        second_buffer(number_of_local_points * dim);
+    Array<int, para_dim> element, first_support;
+
+    for (Index e{begin}; e < end; ++e) {
+      // element's multi-index and the first control point of its support
+      Index remainder{e};
+      Index offset{};
+      for (int i{}; i < para_dim; ++i) {
+        element[i] = static_cast<int>(remainder % number_of_elements[i]);
+        remainder /= number_of_elements[i];
+        const int& span =
+            std::get<0>(*extraction_information[i])[element[i]];
+        first_support[i] = span - number_of_bezier_points[i] + 1;
+        offset += first_support[i] * global_strides[i];
+
+        bounds(e, i) = knots[i][span];
+        bounds(e, para_dim + i) = knots[i][span + 1];
+      }
+
+      // gather control points of the element
+      Type_* input = first_buffer.data_;
+      Type_* output = second_buffer.data_;
+      StridedIndex_ support{number_of_non_zero_basis_functions,
+                            global_strides,
+                            offset};
+      for (int l{}; l < number_of_local_points; ++l, ++support) {
+        const Type_* coordinate =
+            coordinates + support.GetIndex1d() * coordinate_stride;
+        for (int j{}; j < dim; ++j) {
+          input[l * dim + j] = coordinate[j * component_stride];
+        }
+      }
+
+      // Q(..., b_i, ...) = sum_a C_e^i(a, b_i) P(..., a, ...)
+      for (int i{}; i < para_dim; ++i) {
+        const auto& operators = std::get<1>(*extraction_information[i]);
+        const int& n = number_of_bezier_points[i];
+        const int& stride = local_strides[i];
+        for (int l{}; l < number_of_local_points; ++l) {
+          const int b = (l / stride) % n;
+          const int first = l - b * stride;
+          Type_* out = output + l * dim;
+          std::fill_n(out, dim, Type_{});
+          for (int a{}; a < n; ++a) {
+            const Type_& coefficient = operators(element[i], a, b);
+            if (coefficient == 0.0) {
+              continue;
+            }
+            const Type_* in = input + (first + a * stride) * dim;
+            for (int j{}; j < dim; ++j) {
+              out[j] += coefficient * in[j];
+            }
+          }
+        }
+        std::swap(input, output);
+      }
+
+      std::copy_n(input,
+                  number_of_local_points * dim,
+                  &patches(static_cast<Index>(e) * number_of_local_points, 0));
+    }
+  };
+
+  utilities::parallel_operations::NThreadExecution(extract,
+                                                   total_number_of_elements,
+                                                   execution_policy);
+
+  return bezier_patches;
+}
+
+template<int para_dim>
+void BSpline<para_dim>::ThrowIfFieldsAreIncompatible(
+    Fields_ const& fields) const {
+  using std::to_string;
+
+  // validated in all builds as mismatched fields would be read out of bounds
+  Index const& total_number_of_basis_functions =
+      Base_::parameter_space_->GetTotalNumberOfBasisFunctions();
+  for (SharedPointer<VectorSpace_> const& field : fields) {
+    Index const& number_of_coordinates = field->GetNumberOfCoordinates();
+    if (number_of_coordinates != total_number_of_basis_functions)
+      Throw(DomainError(to_string(number_of_coordinates)
+                        + " coordinates were provided by a field but "
+                        + to_string(total_number_of_basis_functions)
+                        + " are needed to associate each basis function "
+                          "with a coordinate."),
+            "bsplinelib::splines::BSpline::ThrowIfFieldsAreIncompatible");
+  }
+}
+
+// Lines of all vector spaces are enumerated together, i.e., work is balanced
+// across fields and lines.
+template<int para_dim>
+template<typename LineOperation>
+bool BSpline<para_dim>::TransformLines(
+    Fields_ const& fields,
+    Dimension const& dimension,
+    IndexLength_ const& number_of_coordinates,
+    Index const& new_length,
+    LineOperation const& line_operation,
+    ExecutionPolicy_ const& execution_policy) const {
+  const Index length = number_of_coordinates[dimension];
+
+  // fields may share this spline's vector space, which must be rebuilt once
+  Vector<VectorSpace_*> vector_spaces{vector_space_.get()};
+  int maximum_dim{vector_space_->Dim()};
+  for (SharedPointer<VectorSpace_> const& field : fields) {
+    if (std::find(vector_spaces.begin(), vector_spaces.end(), field.get())
+        == vector_spaces.end()) {
+      vector_spaces.push_back(field.get());
+      maximum_dim = std::max(maximum_dim, field->Dim());
+    }
+  }
+  const Index number_of_vector_spaces =
+      static_cast<Index>(vector_spaces.size());
+
+  // coordinates are stored with the first dimension running fastest, i.e., a
+  // line is strided by the number of coordinates of preceding dimensions
+  Index stride{1}, number_of_lines{1};
+  for (int i{}; i < para_dim; ++i) {
+    if (i < dimension) {
+      stride *= number_of_coordinates[i];
+    }
+    if (i != dimension) {
+      number_of_lines *= number_of_coordinates[i];
+    }
+  }
+
+  // new coordinates are stored in the layout of their vector space
+  Vector<Coordinates_> new_coordinates;
+  new_coordinates.reserve(number_of_vector_spaces);
+  for (VectorSpace_* const& vector_space : vector_spaces) {
+    if (vector_space->GetLayout()
+        == vector_spaces::Layout::kArrayOfStructures) {
+      new_coordinates.emplace_back(number_of_lines * new_length,
+                                   vector_space->Dim());
+    } else {
+      new_coordinates.emplace_back(vector_space->Dim(),
+                                   number_of_lines * new_length);
+    }
+  }
+  std::atomic<bool> successful{true};
+  auto transform = [&](Index const& begin, Index const& end) {
+    TemporaryData_<Type_> line(length * maximum_dim),
+        new_line(new_length * maximum_dim),
+        workspace(std::max(length, new_length) * maximum_dim);
+    for (Index l{begin}; l < end; ++l) {
+      if (!successful.load(std::memory_order_relaxed)) {
+        return;
+      }
+      const Index v = l / number_of_lines, current_line = l % number_of_lines;
+      VectorSpace_ const& vector_space = *vector_spaces[v];
+      const Type_* coordinates = vector_space.GetCoordinates().data();
+      Type_* current_new_coordinates = new_coordinates[v].data();
+      const int dim = vector_space.Dim();
+      const Index coordinate_stride = vector_space.GetCoordinateStride(),
+                  component_stride = vector_space.GetComponentStride(),
+                  new_component_stride =
+                      vector_space.GetLayout()
+                              == vector_spaces::Layout::kArrayOfStructures
+                          ? 1
+                          : number_of_lines * new_length;
+      const Index inner = current_line % stride, outer = current_line / stride;
+      const Index first = inner + outer * stride * length,
+                  new_first = inner + outer * stride * new_length;
+      for (Index j{}; j < length; ++j) {
+        const Type_* coordinate =
+            coordinates + (first + j * stride) * coordinate_stride;
+        for (int k{}; k < dim; ++k) {
+          line.data_[j * dim + k] = coordinate[k * component_stride];
+        }
+      }
+      if (!line_operation(line.data_, new_line.data_, workspace.data_, dim)) {
+        successful.store(false, std::memory_order_relaxed);
+        return;
+      }
+      for (Index j{}; j < new_length; ++j) {
+        Type_* new_coordinate =
+            current_new_coordinates
+            + (new_first + j * stride) * coordinate_stride;
+        for (int k{}; k < dim; ++k) {
+          new_coordinate[k * new_component_stride] =
+              new_line.data_[j * dim + k];
+        }
+      }
+    }
+  };
+  utilities::parallel_operations::NThreadExecution(
+      transform,
+      number_of_vector_spaces * number_of_lines,
+      execution_policy);
+
+  if (!successful) {
+    return false;
+  }
+  for (Index v{}; v < number_of_vector_spaces; ++v) {
+    vector_spaces[v]->SetCoordinates(std::move(new_coordinates[v]));
+  }
+  return true;
+}
+
+template<int para_dim>
+void BSpline<para_dim>::Combine(
+    BasisValuesPerDimension_ const& basis_values_per_dimension,
+    KnotSpans_ const& effective_knot_spans,
+    Coordinate_& evaluated,
+    PackedElementCoordinates_ const* packed) const {
+  ParameterSpace_ const& parameter_space = *Base_::parameter_space_;
+  VectorSpace_ const& vector_space = *vector_space_;
+  IndexValue_ first_non_zero_basis_function;
+  for (int i{}; i < para_dim; ++i) {
+    first_non_zero_basis_function[i] =
+        effective_knot_spans[i].Get() - parameter_space.GetDegree(i);
+  }
+
+  // products of basis values and coordinates are summed in Accumulation, which
+  // may be wider than Type_, and rounded once at the end
+  const int dim = evaluated.size();
+  Array<Accumulation, kStackDimension_> stack_sum{};
+  Vector<Accumulation> heap_sum;
+  Accumulation* sum = stack_sum.data();
+  if (dim > kStackDimension_) {
+    heap_sum.assign(dim, Accumulation{});
+    sum = heap_sum.data();
+  }
+  // control points stored as rows of dim components starting at points
+  auto const accumulate_rows = [&](const Type_* points) {
+    return [&, points](Index const& i, Accumulation const& factor) {
+      const Type_* coordinate = points + i * dim;
+      for (int j{}; j < dim; ++j) {
+        sum[j] += factor * coordinate[j];
+      }
+    };
+  };
+
+  Index element{};
+  if (packed) {
+    for (int i{}; i < para_dim; ++i) {
+      const Index& element_i =
+          packed->elements_[i][first_non_zero_basis_function[i]];
+      if (element_i < 0) {
+        element = -1;
+        break;
+      }
+      element += element_i * packed->element_strides_[i];
+    }
+  }
+
+  if (packed && element >= 0) {
+    // the control points of the element are visited in storage order
+    bsplinelib::parameter_spaces::ContiguousIndex local{};
+    bsplinelib::parameter_spaces::RecursiveAccumulate(
+        basis_values_per_dimension,
+        local,
+        accumulate_rows(packed->coordinates_.data()
+                        + element * packed->block_size_ * dim));
+  } else {
+    StridedIndex_ support{
+        parameter_space.GetNumberOfNonZeroBasisFunctions(),
+        Index_{parameter_space.GetNumberOfBasisFunctions(),
+               first_non_zero_basis_function}};
+    if (vector_space.GetLayout()
+        == vector_spaces::Layout::kArrayOfStructures) {
+      bsplinelib::parameter_spaces::RecursiveAccumulate(
+          basis_values_per_dimension,
+          support,
+          accumulate_rows(vector_space.GetCoordinates().data()));
+    } else {
+      // components of a control point are GetComponentStride() apart
+      const Type_* coordinates = vector_space.GetCoordinates().data();
+      const Index component_stride = vector_space.GetComponentStride();
+      bsplinelib::parameter_spaces::RecursiveAccumulate(
+          basis_values_per_dimension,
+          support,
+          [&](Index const& i, Accumulation const& factor) {
+            const Type_* coordinate = coordinates + i;
+            for (int j{}; j < dim; ++j) {
+              sum[j] += factor * coordinate[j * component_stride];
+            }
+          });
+    }
+  }
+
+  Type_* result = evaluated.data();
+  for (int j{}; j < dim; ++j) {
+    result[j] += static_cast<Type_>(sum[j]);
+  }
+}
+
+template<int para_dim>
+void BSpline<para_dim>::UsePackedElementCoordinates(bool const& use) {
+  use_packed_element_coordinates_ = use;
+  if (!use) {
+    std::lock_guard<std::mutex> lock(packed_element_coordinates_cache_.mutex_);
+    packed_element_coordinates_cache_.packed_.reset();
+  }
+}
+
+template<int para_dim>
+SharedPointer<typename BSpline<para_dim>::PackedElementCoordinates_ const>
+BSpline<para_dim>::GetPackedElementCoordinates() const {
+  ParameterSpace_ const& parameter_space = *Base_::parameter_space_;
+  VectorSpace_ const& vector_space = *vector_space_;
+
+  // refinements replace the coordinates, i.e., change their revision
+  std::lock_guard<std::mutex> lock(packed_element_coordinates_cache_.mutex_);
+  SharedPointer<PackedElementCoordinates_ const>& packed =
+      packed_element_coordinates_cache_.packed_;
+  auto const is_up_to_date = [&] {
+    if (!packed || packed->revision_ != vector_space.GetRevision()
+        || packed->number_of_coordinates_
+               != vector_space.GetNumberOfCoordinates()) {
+      return false;
+    }
+    for (int i{}; i < para_dim; ++i) {
+      if (packed->knot_revisions_[i]
+          != parameter_space.GetKnotVector(i)->GetRevision()) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (is_up_to_date()) {
+    return packed;
+  }
+
+  IndexLength_ const number_of_basis_functions =
+                         parameter_space.GetNumberOfBasisFunctions(),
+                     number_of_local_points =
+                         parameter_space.GetNumberOfNonZeroBasisFunctions();
+  auto new_packed = std::make_shared<PackedElementCoordinates_>();
+  new_packed->revision_ = vector_space.GetRevision();
+  new_packed->number_of_coordinates_ = vector_space.GetNumberOfCoordinates();
+  Array<typename ParameterSpace_::ElementSpans_, para_dim> element_spans;
+  IndexLength_ number_of_elements;
+  for (int i{}; i < para_dim; ++i) {
+    new_packed->knot_revisions_[i] =
+        parameter_space.GetKnotVector(i)->GetRevision();
+    element_spans[i] = parameter_space.DetermineElementSpans(i);
+    number_of_elements[i] = static_cast<Index>(element_spans[i].size());
+    Vector<Index>& elements = new_packed->elements_[i];
+    const int degree = parameter_space.GetDegree(i);
+    elements.assign(number_of_basis_functions[i] - degree, Index{-1});
+    for (Index e{}; e < number_of_elements[i]; ++e) {
+      elements[element_spans[i][e] - degree] = e;
+    }
+  }
+  StridedIndex_ const local_points{number_of_local_points};
+  StridedIndex_ element{number_of_elements};
+  new_packed->element_strides_ = element.GetStride();
+  new_packed->block_size_ = local_points.GetTotalNumberOfIndices();
+
+  // gather the control points of each element, control points within an
+  // element only ever step by one of the global strides
+  const int dim = vector_space.Dim();
+  const Index coordinate_stride = vector_space.GetCoordinateStride(),
+              component_stride = vector_space.GetComponentStride(),
+              total_number_of_elements = element.GetTotalNumberOfIndices();
+  typename StridedIndex_::Stride_ const global_strides =
+      StridedIndex_{number_of_basis_functions}.GetStride();
+  Coordinates_& packed_coordinates = new_packed->coordinates_;
+  packed_coordinates =
+      Coordinates_(total_number_of_elements * new_packed->block_size_, dim);
+  const Type_* coordinates = vector_space.GetCoordinates().data();
+  Type_* packed_coordinate = packed_coordinates.data();
+  for (Index b{}; b < total_number_of_elements; ++b, ++element) {
+    Index first{};
+    for (int i{}; i < para_dim; ++i) {
+      first += (element_spans[i][element.GetValue()[i]]
+                - parameter_space.GetDegree(i))
+               * global_strides[i];
+    }
+    StridedIndex_ support{number_of_local_points, global_strides, first};
+    for (Index l{}; l < new_packed->block_size_; ++l, ++support) {
+      const Type_* coordinate =
+          coordinates + support.GetIndex1d() * coordinate_stride;
+      for (int j{}; j < dim; ++j) {
+        *packed_coordinate++ = coordinate[j * component_stride];
+      }
+    }
+  }
+
+  packed = std::move(new_packed);
+  return packed;
+}
+
 // See NURBS book p. 169.
 template<int para_dim>
 typename BSpline<para_dim>::BezierInformation_
@@ -0,0 +1,126 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_SPLINES_HIERARCHICAL_B_SPLINE_HPP_
+#define SOURCES_SPLINES_HIERARCHICAL_B_SPLINE_HPP_
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/hierarchical_parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/Utilities/math_operations.hpp"
+#include "BSplineLib/Utilities/named_type.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::splines {
+
+/// @brief HierarchicalBSplines are splines w.r.t. truncated hierarchical
+/// B-splines (see HierarchicalParameterSpace) and allow for local refinement.
+/// Coordinates correspond to the parameter space's active functions. Rational
+/// splines can be refined using homogeneous coordinates.
+///
+/// Example:
+///   HierarchicalBSpline<2> hierarchical{b_spline};
+///   hierarchical.RefineElements(0, {0, 1});  // The geometry is unchanged.
+///   auto const& coordinate = hierarchical(parametric_coordinate);
+/// @tparam para_dim
+template<int para_dim>
+class HierarchicalBSpline {
+public:
+  using BSpline_ = BSpline<para_dim>;
+  using HierarchicalParameterSpace_ =
+      parameter_spaces::HierarchicalParameterSpace<para_dim>;
+  using ParameterSpace_ = typename BSpline_::ParameterSpace_;
+  using VectorSpace_ = typename BSpline_::VectorSpace_;
+  using Coordinate_ = typename BSpline_::Coordinate_;
+  using Coordinates_ = typename BSpline_::Coordinates_;
+  using Elements_ = typename HierarchicalParameterSpace_::Elements_;
+  using Type_ = typename BSpline_::Type_;
+  using IntType_ = typename BSpline_::IntType_;
+
+  HierarchicalBSpline() = default;
+  HierarchicalBSpline(
+      SharedPointer<HierarchicalParameterSpace_> parameter_space,
+      SharedPointer<VectorSpace_> vector_space);
+  /// @brief Uses a copy of the parameter space as level 0, i.e., the spline
+  /// equals the B-spline given by the parameter and vector space.
+  /// @param parameter_space
+  /// @param vector_space
+  /// @param tolerance
+  HierarchicalBSpline(ParameterSpace_ const& parameter_space,
+                      SharedPointer<VectorSpace_> vector_space,
+                      Tolerance const& tolerance = kEpsilon);
+  HierarchicalBSpline(HierarchicalBSpline const& other) = default;
+  HierarchicalBSpline(HierarchicalBSpline&& other) noexcept = default;
+  HierarchicalBSpline& operator=(HierarchicalBSpline const& rhs) = default;
+  HierarchicalBSpline& operator=(HierarchicalBSpline&& rhs) noexcept = default;
+  virtual ~HierarchicalBSpline() = default;
+
+  virtual int Dim() const { return vector_space_->Dim(); }
+
+  void Evaluate(const Type_* parametric_coordinate, Type_* evaluated) const;
+  void EvaluateDerivative(const Type_* parametric_coordinate,
+                          const IntType_* derivative,
+                          Type_* evaluated) const;
+  Coordinate_ operator()(const Type_* parametric_coordinate) const;
+  Coordinate_ operator()(const Type_* parametric_coordinate,
+                         const IntType_* derivative) const;
+
+  /// @brief Refines given elements of given level and transfers coordinates
+  /// exactly, i.e., the spline is not changed. The coefficient of an active
+  /// function of level l equals the one of its B-spline in the level l
+  /// representation of the spline, which is determined by interpolation on a
+  /// single element of the support. Parameter and vector space are replaced
+  /// by refined copies, i.e., splines sharing them are not affected.
+  /// @param level
+  /// @param elements flat element indices of the level
+  /// @param tolerance
+  virtual void RefineElements(int const& level,
+                              Elements_ const& elements,
+                              Tolerance const& tolerance = kEpsilon);
+
+  virtual SharedPointer<HierarchicalParameterSpace_> const&
+  GetParameterSpace() const {
+    return parameter_space_;
+  }
+  virtual SharedPointer<VectorSpace_> const& GetVectorSpace() const {
+    return vector_space_;
+  }
+
+protected:
+  SharedPointer<HierarchicalParameterSpace_> parameter_space_;
+  SharedPointer<VectorSpace_> vector_space_;
+
+private:
+  // Interpolates the spline on given element of given level w.r.t. the level's
+  // B-splines that are non-zero on the element.
+  Coordinates_ InterpolateOnElement(ParameterSpace_ const& parameter_space,
+                                    Array<int, para_dim> const& element_spans,
+                                    Tolerance const& tolerance) const;
+};
+
+#include "BSplineLib/Splines/hierarchical_b_spline.inl"
+
+} // namespace bsplinelib::splines
+
+#endif // SOURCES_SPLINES_HIERARCHICAL_B_SPLINE_HPP_
@@ -0,0 +1,273 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<int para_dim>
+HierarchicalBSpline<para_dim>::HierarchicalBSpline(
+    SharedPointer<HierarchicalParameterSpace_> parameter_space,
+    SharedPointer<VectorSpace_> vector_space)
+    : parameter_space_(std::move(parameter_space)),
+      vector_space_(std::move(vector_space)) {
+#ifndef NDEBUG
+  if (parameter_space_->GetTotalNumberOfBasisFunctions()
+      != vector_space_->GetNumberOfCoordinates()) {
+    throw DomainError(
+        "HierarchicalBSpline - number of active functions ("
+        + std::to_string(parameter_space_->GetTotalNumberOfBasisFunctions())
+        + ") and coordinates ("
+        + std::to_string(vector_space_->GetNumberOfCoordinates())
+        + ") have to match.");
+  }
+#endif
+}
+
+template<int para_dim>
+HierarchicalBSpline<para_dim>::HierarchicalBSpline(
+    ParameterSpace_ const& parameter_space,
+    SharedPointer<VectorSpace_> vector_space,
+    Tolerance const& tolerance)
+    : HierarchicalBSpline(
+        std::make_shared<HierarchicalParameterSpace_>(parameter_space,
+                                                      tolerance),
+        std::move(vector_space)) {}
+
+template<int para_dim>
+void HierarchicalBSpline<para_dim>::Evaluate(
+    const Type_* parametric_coordinate,
+    Type_* evaluated) const {
+  auto const& [functions, values] =
+      parameter_space_->EvaluateBasisValues(parametric_coordinate);
+  VectorSpace_ const& vector_space = *vector_space_;
+  const int dimension = Dim();
+  std::fill_n(evaluated, dimension, Type_{});
+  for (std::size_t k{}; k < functions.size(); ++k) {
+    for (int i{}; i < dimension; ++i) {
+      evaluated[i] += values[k] * vector_space(functions[k], i);
+    }
+  }
+}
+
+template<int para_dim>
+void HierarchicalBSpline<para_dim>::EvaluateDerivative(
+    const Type_* parametric_coordinate,
+    const IntType_* derivative,
+    Type_* evaluated) const {
+  auto const& [functions, values] =
+      parameter_space_->EvaluateBasisDerivativeValues(parametric_coordinate,
+                                                      derivative);
+  VectorSpace_ const& vector_space = *vector_space_;
+  const int dimension = Dim();
+  std::fill_n(evaluated, dimension, Type_{});
+  for (std::size_t k{}; k < functions.size(); ++k) {
+    for (int i{}; i < dimension; ++i) {
+      evaluated[i] += values[k] * vector_space(functions[k], i);
+    }
+  }
+}
+
+template<int para_dim>
+typename HierarchicalBSpline<para_dim>::Coordinate_
+HierarchicalBSpline<para_dim>::operator()(
+    const Type_* parametric_coordinate) const {
+  Coordinate_ evaluated(Dim());
+
+  Evaluate(parametric_coordinate, evaluated.data());
+
+  return evaluated;
+}
+
+template<int para_dim>
+typename HierarchicalBSpline<para_dim>::Coordinate_
+HierarchicalBSpline<para_dim>::operator()(const Type_* parametric_coordinate,
+                                          const IntType_* derivative) const {
+  Coordinate_ evaluated(Dim());
+
+  EvaluateDerivative(parametric_coordinate, derivative, evaluated.data());
+
+  return evaluated;
+}
+
+template<int para_dim>
+void HierarchicalBSpline<para_dim>::RefineElements(int const& level,
+                                                   Elements_ const& elements,
+                                                   Tolerance const& tolerance) {
+  // The spline before refinement provides the values to interpolate.  Spaces
+  // may be shared with other splines and are replaced rather than modified.
+  HierarchicalBSpline const coarse{parameter_space_, vector_space_};
+  auto refined =
+      std::make_shared<HierarchicalParameterSpace_>(*parameter_space_);
+  refined->RefineElements(level, elements);
+  parameter_space_ = std::move(refined);
+
+  auto const& basis_functions = parameter_space_->GetBasisFunctions();
+  const int number_of_levels = parameter_space_->GetNumberOfLevels(),
+            dimension = Dim();
+  Vector<Array<typename ParameterSpace_::ElementSpans_, para_dim>>
+      element_spans(number_of_levels);
+  for (int l{}; l < number_of_levels; ++l) {
+    for (int i{}; i < para_dim; ++i) {
+      element_spans[l][i] =
+          parameter_space_->GetLevel(l)->DetermineElementSpans(Dimension{i},
+                                                               tolerance);
+    }
+  }
+
+  // interpolations are shared by all active functions of an element
+  std::map<std::pair<int, int>, Coordinates_> interpolations;
+  Coordinates_ coordinates(static_cast<int>(basis_functions.size()),
+                           dimension);
+  for (std::size_t active{}; active < basis_functions.size(); ++active) {
+    auto const& [l, function] = basis_functions[active];
+    ParameterSpace_ const& parameter_space = *parameter_space_->GetLevel(l);
+    auto const number_of_basis_functions =
+        parameter_space.GetNumberOfBasisFunctions();
+    auto const& number_of_elements = parameter_space_->GetNumberOfElements(l);
+
+    // elements of the support: B-spline i is supported on spans [i, i+p]
+    Array<int, para_dim> index, begin, end, element;
+    int remainder{function};
+    for (int i{}; i < para_dim; ++i) {
+      index[i] = remainder % number_of_basis_functions[i];
+      remainder /= number_of_basis_functions[i];
+      auto const& spans = element_spans[l][i];
+      begin[i] = element[i] = static_cast<int>(
+          std::lower_bound(spans.begin(), spans.end(), index[i])
+          - spans.begin());
+      end[i] = static_cast<int>(
+          std::upper_bound(spans.begin(),
+                           spans.end(),
+                           index[i] + parameter_space.GetDegree(i))
+          - spans.begin());
+    }
+    int flat_element{};
+    while (true) {
+      flat_element = 0;
+      for (int i{para_dim - 1}; i >= 0; --i) {
+        flat_element = flat_element * number_of_elements[i] + element[i];
+      }
+      if (parameter_space_->IsElementActive(l, flat_element)) {
+        break;
+      }
+      int i{};
+      for (; i < para_dim; ++i) {
+        if (++element[i] < end[i]) {
+          break;
+        }
+        element[i] = begin[i];
+      }
+      if (i == para_dim) {
+        throw RuntimeError("HierarchicalBSpline::RefineElements - active "
+                           "function without active element in its support.");
+      }
+    }
+
+    auto interpolation = interpolations.find({l, flat_element});
+    if (interpolation == interpolations.end()) {
+      Array<int, para_dim> spans;
+      for (int i{}; i < para_dim; ++i) {
+        spans[i] = element_spans[l][i][element[i]];
+      }
+      interpolation =
+          interpolations
+              .emplace(std::make_pair(l, flat_element),
+                       coarse.InterpolateOnElement(parameter_space,
+                                                   spans,
+                                                   tolerance))
+              .first;
+    }
+
+    // local index of the B-spline w.r.t. the element
+    int local{}, stride{1};
+    for (int i{}; i < para_dim; ++i) {
+      local += (index[i] - element_spans[l][i][element[i]]
+                + parameter_space.GetDegree(i))
+               * stride;
+      stride *= parameter_space.GetDegree(i) + 1;
+    }
+    for (int i{}; i < dimension; ++i) {
+      coordinates(static_cast<int>(active), i) =
+          interpolation->second(local, i);
+    }
+  }
+
+  vector_space_ = std::make_shared<VectorSpace_>(std::move(coordinates),
+                                                vector_space_->GetLayout());
+}
+
+template<int para_dim>
+typename HierarchicalBSpline<para_dim>::Coordinates_
+HierarchicalBSpline<para_dim>::InterpolateOnElement(
+    ParameterSpace_ const& parameter_space,
+    Array<int, para_dim> const& element_spans,
+    Tolerance const& tolerance) const {
+  // (p+1) points per dimension in the interior of the element
+  Array<Vector<Type_>, para_dim> points;
+  int number_of_functions{1};
+  for (int i{}; i < para_dim; ++i) {
+    const Type_* knots = parameter_space.GetKnotVector(i)->GetData();
+    const int degree = parameter_space.GetDegree(i);
+    const Type_ &lower = knots[element_spans[i]],
+                &upper = knots[element_spans[i] + 1];
+    for (int k{}; k <= degree; ++k) {
+      points[i].push_back(lower + (upper - lower) * (k + 1) / (degree + 2));
+    }
+    number_of_functions *= degree + 1;
+  }
+
+  const int dimension = Dim();
+  utilities::containers::TemporaryData2D<Type_> matrix(number_of_functions,
+                                                       number_of_functions);
+  Coordinates_ values(number_of_functions, dimension);
+  Array<int, para_dim> point{};
+  Array<Type_, para_dim> parametric_coordinate;
+  for (int row{}; row < number_of_functions; ++row) {
+    for (int i{}; i < para_dim; ++i) {
+      parametric_coordinate[i] = points[i][point[i]];
+    }
+    Evaluate(parametric_coordinate.data(), &values(row, 0));
+    auto const& basis_values_per_dimension =
+        parameter_space.EvaluateBasisValuesPerDimension(
+            parametric_coordinate.data(),
+            tolerance);
+    Array<int, para_dim> function{};
+    for (int column{}; column < number_of_functions; ++column) {
+      Type_ value{1.0};
+      for (int i{}; i < para_dim; ++i) {
+        value *= basis_values_per_dimension[i][function[i]];
+      }
+      matrix(row, column) = value;
+      for (int i{}; i < para_dim; ++i) {
+        if (++function[i] <= parameter_space.GetDegree(i)) {
+          break;
+        }
+        function[i] = 0;
+      }
+    }
+    for (int i{}; i < para_dim; ++i) {
+      if (++point[i] <= parameter_space.GetDegree(i)) {
+        break;
+      }
+      point[i] = 0;
+    }
+  }
+  utilities::math_operations::SolveLinearSystem(number_of_functions,
+                                                dimension,
+                                                matrix.data_,
+                                                values.data());
+  return values;
+}
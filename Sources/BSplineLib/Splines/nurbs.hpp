@@ -45,10 +45,13 @@ public:
   using Base_ = Spline<para_dim>;
   using Coordinate_ = typename Base_::Coordinate_;
   using Derivative_ = typename Base_::Derivative_;
+  using ExecutionPolicy_ = typename Base_::ExecutionPolicy_;
   using Knot_ = typename Base_::Knot_;
   using ParameterSpace_ = typename Base_::ParameterSpace_;
   using ParametricCoordinate_ = typename Base_::ParametricCoordinate_;
+  using RefinementPlan_ = typename Base_::RefinementPlan_;
   using WeightedVectorSpace_ = vector_spaces::WeightedVectorSpace;
+  using Fields_ = typename BSpline<para_dim>::Fields_;
   using OutputInformation_ =
       Tuple<typename ParameterSpace_::OutputInformation_,
             typename WeightedVectorSpace_::OutputInformation_>;
@@ -56,6 +59,12 @@ public:
   using Type_ = typename ParameterSpace_::Type_;
   using IntType_ = typename ParameterSpace_::IntType_;
 
+  using Coordinates_ = typename Base_::Coordinates_;
+  using Weights_ = typename WeightedVectorSpace_::Weights_;
+  using ParametricBounds_ = typename BSpline<para_dim>::ParametricBounds_;
+  using BezierPatches_ = Tuple<Coordinates_, Weights_, ParametricBounds_>;
+  using Split_ = Array<SharedPointer<Nurbs>, 2>;
+
   Nurbs();
   Nurbs(SharedPointer<ParameterSpace_> parameter_space,
         SharedPointer<WeightedVectorSpace_> weighted_vector_space);
@@ -76,6 +85,19 @@ public:
   void EvaluateDerivative(const Type_* parametric_coordinate,
                           const IntType_* derivative,
                           Type_* evaluated) const;
+  /// @brief Evaluates the homogeneous B-spline at many parametric coordinates
+  /// and projects the results. See BSpline::EvaluateBatch.
+  /// @param parametric_coordinates (number_of_parametric_coordinates x
+  /// para_dim) array
+  /// @param number_of_parametric_coordinates
+  /// @param evaluated (number_of_parametric_coordinates x dim) array
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @param order_by_element see BSpline::EvaluateBatch
+  void EvaluateBatch(const Type_* parametric_coordinates,
+                     Index const& number_of_parametric_coordinates,
+                     Type_* evaluated,
+                     ExecutionPolicy_ const& execution_policy = {},
+                     bool const& order_by_element = false) const;
 
   Coordinate_ operator()(const Type_* parametric_coordinate) const final;
   Coordinate_ operator()(const Type_* parametric_coordinate,
@@ -84,23 +106,98 @@ public:
   void InsertKnot(Dimension const& dimension,
                   Knot_ knot,
                   Multiplicity const& multiplicity = kMultiplicity,
-                  Tolerance const& tolerance = kEpsilon) const final;
+                  Tolerance const& tolerance = kEpsilon,
+                  ExecutionPolicy_ const& execution_policy =
+                      Base_::GetDefaultExecutionPolicy()) const final;
   Multiplicity RemoveKnot(Dimension const& dimension,
                           Knot_ const& knot,
                           Tolerance const& tolerance_removal,
                           Multiplicity const& multiplicity = kMultiplicity,
-                          Tolerance const& tolerance = kEpsilon) const final;
+                          Tolerance const& tolerance = kEpsilon,
+                          ExecutionPolicy_ const& execution_policy =
+                              Base_::GetDefaultExecutionPolicy()) const final;
   void ElevateDegree(Dimension const& dimension,
                      Multiplicity const& multiplicity = kMultiplicity,
-                     Tolerance const& tolerance = kEpsilon) const final;
+                     Tolerance const& tolerance = kEpsilon,
+                     ExecutionPolicy_ const& execution_policy =
+                         Base_::GetDefaultExecutionPolicy()) const final;
   bool ReduceDegree(Dimension const& dimension,
                     Tolerance const& tolerance_removal,
                     Multiplicity const& multiplicity = kMultiplicity,
-                    Tolerance const& tolerance = kEpsilon) const final;
+                    Tolerance const& tolerance = kEpsilon,
+                    ExecutionPolicy_ const& execution_policy =
+                        Base_::GetDefaultExecutionPolicy()) const final;
+
+  void Refine(RefinementPlan_ const& plan,
+              Tolerance const& tolerance = kEpsilon,
+              ExecutionPolicy_ const& execution_policy =
+                  Base_::GetDefaultExecutionPolicy()) const final;
+
+  /// @brief Refines this spline and all fields at once. Weighted vector spaces
+  /// are refined using their homogeneous coordinates. See
+  /// BSpline::InsertKnot(fields, ...).
+  /// @param fields vector spaces with one coordinate per basis function
+  /// @param dimension
+  /// @param knot
+  /// @param multiplicity
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  void InsertKnot(Fields_ const& fields,
+                  Dimension const& dimension,
+                  Knot_ knot,
+                  Multiplicity const& multiplicity = kMultiplicity,
+                  Tolerance const& tolerance = kEpsilon,
+                  ExecutionPolicy_ const& execution_policy =
+                      Base_::GetDefaultExecutionPolicy()) const;
+  void ElevateDegree(Fields_ const& fields,
+                     Dimension const& dimension,
+                     Multiplicity const& multiplicity = kMultiplicity,
+                     Tolerance const& tolerance = kEpsilon,
+                     ExecutionPolicy_ const& execution_policy =
+                         Base_::GetDefaultExecutionPolicy()) const;
+  void Refine(Fields_ const& fields,
+              RefinementPlan_ const& plan,
+              Tolerance const& tolerance = kEpsilon,
+              ExecutionPolicy_ const& execution_policy =
+                  Base_::GetDefaultExecutionPolicy()) const;
+
+  /// @brief Splits this NURBS at the knot using its homogeneous coordinates.
+  /// See BSpline::Split.
+  /// @param dimension
+  /// @param knot has to lie in the interior of the dimension
+  /// @param tolerance
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @return
+  Split_ Split(Dimension const& dimension,
+               Knot_ const& knot,
+               Tolerance const& tolerance = kEpsilon,
+               ExecutionPolicy_ const& execution_policy =
+                   Base_::GetDefaultExecutionPolicy()) const;
 
   Coordinate ComputeUpperBoundForMaximumDistanceFromOrigin() const final;
   OutputInformation_ Write(Precision const& precision = kPrecision) const;
 
+  /// @brief Extracts rational Bezier patches of all elements. See
+  /// BSpline::ExtractBezierPatches for the ordering.
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @param tolerance
+  /// @return projected control points, weights and parametric bounds
+  BezierPatches_
+  ExtractBezierPatches(ExecutionPolicy_ const& execution_policy = {},
+                       Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Packs the homogeneous coordinates of each element. See
+  /// BSpline::UsePackedElementCoordinates.
+  /// @param use
+  void UsePackedElementCoordinates(bool const& use) {
+    homogeneous_b_spline_->UsePackedElementCoordinates(use);
+  }
+  /// @brief
+  /// @return whether evaluations read packed element coordinates
+  bool const& IsUsingPackedElementCoordinates() const {
+    return homogeneous_b_spline_->IsUsingPackedElementCoordinates();
+  }
+
   /// @brief
   /// @param from
   /// @param to
@@ -113,8 +210,8 @@ public:
 protected:
   using HomogeneousBSpline_ = BSpline<para_dim>;
 
-  SharedPointer<HomogeneousBSpline_> homogeneous_b_spline_;
   SharedPointer<WeightedVectorSpace_> weighted_vector_space_;
+  SharedPointer<HomogeneousBSpline_> homogeneous_b_spline_;
 };
 
 #include "BSplineLib/Splines/nurbs.inl"
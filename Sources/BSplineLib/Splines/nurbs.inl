@@ -28,10 +28,10 @@ Nurbs<para_dim>::Nurbs(
   using std::to_string;
 
 #ifndef NDEBUG
-  int const &total_number_of_basis_functions =
-                Base_::parameter_space_->GetTotalNumberOfBasisFunctions(),
-            &number_of_coordinates =
-                weighted_vector_space->GetNumberOfCoordinates();
+  Index const &total_number_of_basis_functions =
+                  Base_::parameter_space_->GetTotalNumberOfBasisFunctions(),
+              &number_of_coordinates =
+                  weighted_vector_space->GetNumberOfCoordinates();
   if (number_of_coordinates != total_number_of_basis_functions)
     Throw(DomainError(to_string(number_of_coordinates)
                       + " coordinates were provided but "
@@ -53,7 +53,9 @@ Nurbs<para_dim>::Nurbs(Nurbs const& other)
           *other.weighted_vector_space_)},
       homogeneous_b_spline_{
           std::make_shared<HomogeneousBSpline_>(Base_::parameter_space_,
-                                                weighted_vector_space_)} {}
+                                                weighted_vector_space_)} {
+  UsePackedElementCoordinates(other.IsUsingPackedElementCoordinates());
+}
 
 template<int para_dim>
 Nurbs<para_dim>& Nurbs<para_dim>::operator=(Nurbs const& rhs) {
@@ -63,6 +65,7 @@ Nurbs<para_dim>& Nurbs<para_dim>::operator=(Nurbs const& rhs) {
   homogeneous_b_spline_ =
       std::make_shared<HomogeneousBSpline_>(Base_::parameter_space_,
                                             weighted_vector_space_);
+  UsePackedElementCoordinates(rhs.IsUsingPackedElementCoordinates());
   return *this;
 }
 
@@ -83,13 +86,40 @@ void Nurbs<para_dim>::Evaluate(const Type_* parametric_coordinate,
   }
 }
 
+template<int para_dim>
+void Nurbs<para_dim>::EvaluateBatch(
+    const Type_* parametric_coordinates,
+    Index const& number_of_parametric_coordinates,
+    Type_* evaluated,
+    ExecutionPolicy_ const& execution_policy,
+    bool const& order_by_element) const {
+  const int h_dim = weighted_vector_space_->Dim();
+  const int dim = h_dim - 1;
+
+  Coordinates_ homogeneous_eval(number_of_parametric_coordinates, h_dim);
+  homogeneous_b_spline_->EvaluateBatch(parametric_coordinates,
+                                       number_of_parametric_coordinates,
+                                       homogeneous_eval.data(),
+                                       execution_policy,
+                                       order_by_element);
+
+  for (Index j{}; j < number_of_parametric_coordinates; ++j) {
+    const Type_* eval_ptr = &homogeneous_eval(j, 0);
+    const Type_ w_inv = 1. / eval_ptr[dim];
+    for (int i{}; i < dim; ++i) {
+      *evaluated++ = *eval_ptr++ * w_inv;
+    }
+  }
+}
+
 template<int para_dim>
 void Nurbs<para_dim>::EvaluateDerivative(const Type_* parametric_coordinate,
                                          const IntType_* derivative,
                                          Type_* evaluated) const {
 
-  using Data = bsplinelib::utilities::containers::Data<double>;
-  using Data2D = bsplinelib::utilities::containers::Data<double, 2>;
+  using Data = bsplinelib::utilities::containers::Data<Type_>;
+  using Data2D = bsplinelib::utilities::containers::Data<Type_, 2>;
+  using bsplinelib::utilities::math_operations::DetermineBinomialCoefficient;
 
   // Global (scalar) indexing to local index-system
   auto multi_index_ = [&derivative](int id) -> std::array<int, para_dim> {
@@ -151,7 +181,7 @@ void Nurbs<para_dim>::EvaluateDerivative(const Type_* parametric_coordinate,
   }
 
   // Precompute inverse of weighted function
-  const double inv_w_fact = 1. / homogeneous_der(0, dim);
+  const Type_ inv_w_fact = static_cast<Type_>(1.0) / homogeneous_der(0, dim);
 
   // Loop over all lower-order derivatives and assign derivatives-vector
   // Notation follows "The NURBS book" eq. 4.20 (extended for n-d splines)
@@ -171,12 +201,11 @@ void Nurbs<para_dim>::EvaluateDerivative(const Type_* parametric_coordinate,
                          derivative_order_indexwise_RHS))
         continue;
       // Precompute Product of binomial coefficients
-      int binom_fact{1};
+      Type_ binom_fact{1.0};
       for (int k{}; k < para_dim; ++k) {
-        binom_fact *=
-            bsplinelib::utilities::math_operations::ComputeBinomialCoefficient(
-                derivative_order_indexwise_LHS[k],
-                derivative_order_indexwise_RHS[k]);
+        binom_fact *= static_cast<Type_>(
+            DetermineBinomialCoefficient(derivative_order_indexwise_LHS[k],
+                                         derivative_order_indexwise_RHS[k]));
       }
       // Substract low-order function
       d_row.Add(-(binom_fact * homogeneous_der(j, dim)), &der(i - j, 0));
@@ -213,9 +242,15 @@ template<int para_dim>
 void Nurbs<para_dim>::InsertKnot(Dimension const& dimension,
                                  Knot_ knot,
                                  Multiplicity const& multiplicity,
-                                 Tolerance const& tolerance) const {
+                                 Tolerance const& tolerance,
+                                 ExecutionPolicy_ const& execution_policy)
+    const {
   // bound checks in parameter space
-  homogeneous_b_spline_->InsertKnot(dimension, knot, multiplicity, tolerance);
+  homogeneous_b_spline_->InsertKnot(dimension,
+                                    knot,
+                                    multiplicity,
+                                    tolerance,
+                                    execution_policy);
 }
 
 template<int para_dim>
@@ -223,7 +258,9 @@ Multiplicity Nurbs<para_dim>::RemoveKnot(Dimension const& dimension,
                                          Knot_ const& knot,
                                          Tolerance const& tolerance_removal,
                                          Multiplicity const& multiplicity,
-                                         Tolerance const& tolerance) const {
+                                         Tolerance const& tolerance,
+                                         ExecutionPolicy_ const&
+                                             execution_policy) const {
   using std::get;
 
   auto const& [maximum_distance_from_origin, minimum_weight] =
@@ -237,27 +274,121 @@ Multiplicity Nurbs<para_dim>::RemoveKnot(Dimension const& dimension,
       tolerance_removal
           * (minimum_weight / (1.0 + maximum_distance_from_origin)),
       multiplicity,
-      tolerance);
+      tolerance,
+      execution_policy);
 }
 
 template<int para_dim>
 void Nurbs<para_dim>::ElevateDegree(Dimension const& dimension,
                                     Multiplicity const& multiplicity,
-                                    Tolerance const& tolerance) const {
+                                    Tolerance const& tolerance,
+                                    ExecutionPolicy_ const& execution_policy)
+    const {
   // bound checks in parameter space
-  homogeneous_b_spline_->ElevateDegree(dimension, multiplicity, tolerance);
+  homogeneous_b_spline_->ElevateDegree(dimension,
+                                       multiplicity,
+                                       tolerance,
+                                       execution_policy);
 }
 
 template<int para_dim>
 bool Nurbs<para_dim>::ReduceDegree(Dimension const& dimension,
                                    Tolerance const& tolerance_removal,
                                    Multiplicity const& multiplicity,
-                                   Tolerance const& tolerance) const {
+                                   Tolerance const& tolerance,
+                                   ExecutionPolicy_ const& execution_policy)
+    const {
   // bound checks in parameter space
   return homogeneous_b_spline_->ReduceDegree(dimension,
                                              tolerance_removal,
                                              multiplicity,
-                                             tolerance);
+                                             tolerance,
+                                             execution_policy);
+}
+
+template<int para_dim>
+void Nurbs<para_dim>::Refine(RefinementPlan_ const& plan,
+                             Tolerance const& tolerance,
+                             ExecutionPolicy_ const& execution_policy) const {
+  // bound checks in parameter space
+  homogeneous_b_spline_->Refine(plan, tolerance, execution_policy);
+}
+
+template<int para_dim>
+void Nurbs<para_dim>::InsertKnot(Fields_ const& fields,
+                                 Dimension const& dimension,
+                                 Knot_ knot,
+                                 Multiplicity const& multiplicity,
+                                 Tolerance const& tolerance,
+                                 ExecutionPolicy_ const& execution_policy)
+    const {
+  // bound checks in parameter space
+  homogeneous_b_spline_->InsertKnot(fields,
+                                    dimension,
+                                    knot,
+                                    multiplicity,
+                                    tolerance,
+                                    execution_policy);
+}
+
+template<int para_dim>
+void Nurbs<para_dim>::ElevateDegree(Fields_ const& fields,
+                                    Dimension const& dimension,
+                                    Multiplicity const& multiplicity,
+                                    Tolerance const& tolerance,
+                                    ExecutionPolicy_ const& execution_policy)
+    const {
+  // bound checks in parameter space
+  homogeneous_b_spline_->ElevateDegree(fields,
+                                       dimension,
+                                       multiplicity,
+                                       tolerance,
+                                       execution_policy);
+}
+
+template<int para_dim>
+void Nurbs<para_dim>::Refine(Fields_ const& fields,
+                             RefinementPlan_ const& plan,
+                             Tolerance const& tolerance,
+                             ExecutionPolicy_ const& execution_policy) const {
+  // bound checks in parameter space
+  homogeneous_b_spline_->Refine(fields, plan, tolerance, execution_policy);
+}
+
+template<int para_dim>
+typename Nurbs<para_dim>::Split_
+Nurbs<para_dim>::Split(Dimension const& dimension,
+                       Knot_ const& knot,
+                       Tolerance const& tolerance,
+                       ExecutionPolicy_ const& execution_policy) const {
+  using vector_spaces::Layout;
+
+  // homogeneous coordinates are split as array of structures
+  WeightedVectorSpace_ const& weighted_vector_space = *weighted_vector_space_;
+  const Layout& layout = weighted_vector_space.GetLayout();
+  Coordinates_ array_of_structures;
+  if (layout != Layout::kArrayOfStructures) {
+    array_of_structures =
+        weighted_vector_space.CopyCoordinates(Layout::kArrayOfStructures);
+  }
+  auto sides = Base_::SplitCoordinates(
+      dimension,
+      knot,
+      layout == Layout::kArrayOfStructures
+          ? weighted_vector_space.GetCoordinates()
+          : array_of_structures,
+      tolerance,
+      execution_policy);
+  Split_ splits;
+  for (int i{}; i < 2; ++i) {
+    auto& [parameter_space, homogeneous_coordinates] = sides[i];
+    splits[i] = std::make_shared<Nurbs>(
+        std::move(parameter_space),
+        std::make_shared<WeightedVectorSpace_>(
+            std::move(homogeneous_coordinates),
+            layout));
+  }
+  return splits;
 }
 
 template<int para_dim>
@@ -274,3 +405,29 @@ Nurbs<para_dim>::Write(Precision const& precision) const {
   return OutputInformation_{Base_::parameter_space_->Write(precision),
                             weighted_vector_space_->WriteProjected(precision)};
 }
+
+template<int para_dim>
+typename Nurbs<para_dim>::BezierPatches_
+Nurbs<para_dim>::ExtractBezierPatches(ExecutionPolicy_ const& execution_policy,
+                                      Tolerance const& tolerance) const {
+  auto [homogeneous_patches, bounds] =
+      homogeneous_b_spline_->ExtractBezierPatches(execution_policy,
+                                                  tolerance);
+
+  const int number_of_points = homogeneous_patches.Shape()[0];
+  const int dim = weighted_vector_space_->Dim() - 1;
+  Coordinates_ patches(number_of_points, dim);
+  Weights_ weights(number_of_points);
+  for (int i{}; i < number_of_points; ++i) {
+    const Type_& weight = homogeneous_patches(i, dim);
+    const Type_ w_inv = 1. / weight;
+    weights[i] = weight;
+    for (int j{}; j < dim; ++j) {
+      patches(i, j) = homogeneous_patches(i, j) * w_inv;
+    }
+  }
+
+  return BezierPatches_{std::move(patches),
+                        std::move(weights),
+                        std::move(bounds)};
+}
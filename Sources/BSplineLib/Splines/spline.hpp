@@ -21,6 +21,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #define SOURCES_SPLINES_SPLINE_HPP_
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
 #include "BSplineLib/ParameterSpaces/parameter_space.hpp"
@@ -29,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Utilities/error_handling.hpp"
 #include "BSplineLib/Utilities/named_type.hpp"
 #include "BSplineLib/Utilities/numeric_operations.hpp"
+#include "BSplineLib/Utilities/parallel_operations.hpp"
 #include "BSplineLib/VectorSpaces/vector_space.hpp"
 
 namespace bsplinelib::splines {
@@ -51,11 +53,13 @@ public:
   using Coordinates_ = typename VectorSpace_::Coordinates_;
   using ParameterSpace_ = parameter_spaces::ParameterSpace<para_dim>;
   using Derivative_ = typename ParameterSpace_::Derivative_;
+  using ExecutionPolicy_ = utilities::parallel_operations::ExecutionPolicy;
   using Knot_ = typename ParameterSpace_::Knot_;
   using Knots_ = typename ParameterSpace_::Knots_;
   using NumberOfParametricCoordinates_ =
       typename ParameterSpace_::NumberOfParametricCoordinates_;
   using ParametricCoordinate_ = typename ParameterSpace_::ParametricCoordinate_;
+  using RefinementPlan_ = typename ParameterSpace_::RefinementPlan_;
 
   using Type_ = typename ParameterSpace_::Type_;
   using IntType_ = typename ParameterSpace_::IntType_;
@@ -66,37 +70,83 @@ public:
   virtual Coordinate_ operator()(const Type_* parametric_coordinate,
                                  const IntType_* derivative) const = 0;
 
+  // Global execution policy (see
+  // utilities::parallel_operations::SetDefaultExecutionPolicy).
+  static ExecutionPolicy_ GetDefaultExecutionPolicy() {
+    return utilities::parallel_operations::GetDefaultExecutionPolicy();
+  }
+
+  // Refinement and coarsening rebuild lines of coordinates in parallel
+  // according to the execution policy, which defaults to the global one.
   virtual void InsertKnot(Dimension const& dimension,
                           Knot_ knot,
                           Multiplicity const& multiplicity = kMultiplicity,
-                          Tolerance const& tolerance = kEpsilon) const = 0;
+                          Tolerance const& tolerance = kEpsilon,
+                          ExecutionPolicy_ const& execution_policy =
+                              GetDefaultExecutionPolicy()) const = 0;
   void RefineKnots(Dimension const& dimension,
                    Knots_ knots,
                    Multiplicity const& multiplicity = kMultiplicity,
-                   Tolerance const& tolerance = kEpsilon) const;
+                   Tolerance const& tolerance = kEpsilon,
+                   ExecutionPolicy_ const& execution_policy =
+                       GetDefaultExecutionPolicy()) const;
   virtual Multiplicity
   RemoveKnot(Dimension const& dimension,
              Knot_ const& knot,
              Tolerance const& tolerance_removal,
              Multiplicity const& multiplicity = kMultiplicity,
-             Tolerance const& tolerance = kEpsilon) const = 0;
+             Tolerance const& tolerance = kEpsilon,
+             ExecutionPolicy_ const& execution_policy =
+                 GetDefaultExecutionPolicy()) const = 0;
   Multiplicity CoarsenKnots(Dimension const& dimension,
                             Knots_ const& knots,
                             Tolerance const& tolerance_removal,
                             Multiplicity const& multiplicity = kMultiplicity,
-                            Tolerance const& tolerance = kEpsilon) const;
+                            Tolerance const& tolerance = kEpsilon,
+                            ExecutionPolicy_ const& execution_policy =
+                                GetDefaultExecutionPolicy()) const;
   virtual void ElevateDegree(Dimension const& dimension,
                              Multiplicity const& multiplicity = kMultiplicity,
-                             Tolerance const& tolerance = kEpsilon) const = 0;
+                             Tolerance const& tolerance = kEpsilon,
+                             ExecutionPolicy_ const& execution_policy =
+                                 GetDefaultExecutionPolicy()) const = 0;
   virtual bool ReduceDegree(Dimension const& dimension,
                             Tolerance const& tolerance_reduction,
                             Multiplicity const& multiplicity = kMultiplicity,
-                            Tolerance const& tolerance = kEpsilon) const = 0;
+                            Tolerance const& tolerance = kEpsilon,
+                            ExecutionPolicy_ const& execution_policy =
+                                GetDefaultExecutionPolicy()) const = 0;
+
+  // Refines all dimensions according to the plan with a single rebuild of the
+  // coordinates per refined dimension.
+  virtual void Refine(RefinementPlan_ const& plan,
+                      Tolerance const& tolerance = kEpsilon,
+                      ExecutionPolicy_ const& execution_policy =
+                          GetDefaultExecutionPolicy()) const = 0;
 
   virtual Coordinate ComputeUpperBoundForMaximumDistanceFromOrigin() const = 0;
 
+  /// @brief Refines all splines in given dimension to a common basis, i.e., to
+  /// the maximum degree and the union of their (elevated) knot vectors. Each
+  /// spline is refined by a single plan and splines are processed in parallel.
+  /// Splines must not share parameter spaces.  Their knot vectors of the
+  /// dimension are replaced by refined copies, i.e., other parameter spaces
+  /// sharing them are not affected.  Each refinement executes the policy as
+  /// well, i.e., nested parallelism is best served by a thread pool.
+  /// @param splines
+  /// @param dimension
+  /// @param execution_policy number of threads, thread pool or executor
+  /// @param tolerance
+  static void MakeCompatible(Vector<SharedPointer<Spline>> const& splines,
+                             Dimension const& dimension,
+                             ExecutionPolicy_ const& execution_policy = {},
+                             Tolerance const& tolerance = kEpsilon);
+
 protected:
   using Index_ = typename ParameterSpace_::Index_;
+  // parameter space and coordinates of each side of a split
+  using SplitSides_ =
+      Array<Tuple<SharedPointer<ParameterSpace_>, Coordinates_>, 2>;
 
   Spline() = default;
   explicit Spline(bool is_rational);
@@ -106,6 +156,16 @@ protected:
   Spline& operator=(Spline const& rhs);
   Spline& operator=(Spline&& rhs) noexcept = default;
 
+  // Splits given coordinates, one per basis function, at the knot.  The knot
+  // is raised to multiplicity p on a copy of the parameter space only and the
+  // rows of its prolongation factor that belong to either side are applied
+  // directly, i.e., the refined net is never formed.
+  SplitSides_ SplitCoordinates(Dimension const& dimension,
+                               Knot_ const& knot,
+                               Coordinates_ const& coordinates,
+                               Tolerance const& tolerance,
+                               ExecutionPolicy_ const& execution_policy) const;
+
   SharedPointer<ParameterSpace_> parameter_space_;
 };
 
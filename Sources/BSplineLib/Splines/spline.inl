@@ -21,9 +21,15 @@ template<int para_dim>
 void Spline<para_dim>::RefineKnots(Dimension const& dimension,
                                    Knots_ knots,
                                    Multiplicity const& multiplicity,
-                                   Tolerance const& tolerance) const {
+                                   Tolerance const& tolerance,
+                                   ExecutionPolicy_ const& execution_policy)
+    const {
   std::for_each(knots.begin(), knots.end(), [&](Knot_ const& knot) {
-    InsertKnot(dimension, std::move(knot), multiplicity, tolerance);
+    InsertKnot(dimension,
+               std::move(knot),
+               multiplicity,
+               tolerance,
+               execution_policy);
   });
 }
 
@@ -32,7 +38,9 @@ Multiplicity Spline<para_dim>::CoarsenKnots(Dimension const& dimension,
                                             Knots_ const& knots,
                                             Tolerance const& tolerance_removal,
                                             Multiplicity const& multiplicity,
-                                            Tolerance const& tolerance) const {
+                                            Tolerance const& tolerance,
+                                            ExecutionPolicy_ const&
+                                                execution_policy) const {
   Multiplicity successful_removals{multiplicity};
   std::for_each(knots.begin(), knots.end(), [&](Knot_ const& knot) {
     successful_removals = std::min(successful_removals,
@@ -40,11 +48,80 @@ Multiplicity Spline<para_dim>::CoarsenKnots(Dimension const& dimension,
                                               knot,
                                               tolerance_removal,
                                               multiplicity,
-                                              tolerance));
+                                              tolerance,
+                                              execution_policy));
   });
   return successful_removals;
 }
 
+template<int para_dim>
+void Spline<para_dim>::MakeCompatible(
+    Vector<SharedPointer<Spline>> const& splines,
+    Dimension const& dimension,
+    ExecutionPolicy_ const& execution_policy,
+    Tolerance const& tolerance) {
+  using KnotVector = parameter_spaces::KnotVector;
+
+  const int number_of_splines = static_cast<int>(splines.size());
+  int degree{};
+  for (SharedPointer<Spline> const& spline : splines) {
+    degree = std::max(degree, spline->parameter_space_->GetDegree(dimension));
+  }
+  for (int i{}; i < number_of_splines; ++i) {
+    for (int j{}; j < i; ++j) {
+      if (splines[i]->parameter_space_ == splines[j]->parameter_space_) {
+        throw DomainError("Spline::MakeCompatible - splines "
+                          + std::to_string(j) + " and " + std::to_string(i)
+                          + " share their parameter space.");
+      }
+    }
+  }
+  // Knot vectors may still be shared by parameter spaces (of these or other
+  // splines) and are refined in place, i.e., each spline refines a private
+  // copy.  Copies share the knots until they are modified.
+  for (SharedPointer<Spline> const& spline : splines) {
+    SharedPointer<KnotVector>& knot_vector =
+        spline->parameter_space_->GetKnotVector(dimension);
+    knot_vector = std::make_shared<KnotVector>(*knot_vector);
+  }
+
+  // degree elevation raises the multiplicity of each unique knot
+  Vector<SharedPointer<KnotVector>> knot_vectors;
+  knot_vectors.reserve(number_of_splines);
+  for (SharedPointer<Spline> const& spline : splines) {
+    ParameterSpace_ const& parameter_space = *spline->parameter_space_;
+    SharedPointer<KnotVector> const& knot_vector =
+        parameter_space.GetKnotVector(dimension);
+    const int elevation = degree - parameter_space.GetDegree(dimension);
+    if (elevation == 0) {
+      knot_vectors.push_back(knot_vector);
+    } else {
+      knot_vectors.push_back(std::make_shared<KnotVector>(*knot_vector));
+      knot_vectors.back()->IncreaseMultiplicities(Multiplicity{elevation},
+                                                  tolerance);
+    }
+  }
+  KnotVector const& knot_union =
+      KnotVector::DetermineUnion(knot_vectors, tolerance);
+
+  Vector<RefinementPlan_> plans(number_of_splines);
+  for (int i{}; i < number_of_splines; ++i) {
+    auto& refinement = plans[i][dimension];
+    refinement.degree_ = degree;
+    refinement.knots_ =
+        knot_vectors[i]->DetermineMissingKnots(knot_union, tolerance);
+  }
+
+  utilities::parallel_operations::NThreadExecution(
+      [&](Index const& begin, Index const& end) {
+        for (Index i{begin}; i < end; ++i) {
+          splines[i]->Refine(plans[i], tolerance, execution_policy);
+        }
+      },
+      number_of_splines,
+      execution_policy);
+}
+
 template<int para_dim>
 Spline<para_dim>::Spline(bool is_rational)
     : SplineItem(para_dim, std::move(is_rational)) {}
@@ -70,3 +147,135 @@ Spline<para_dim>& Spline<para_dim>::operator=(Spline const& rhs) {
   parameter_space_ = std::make_shared<ParameterSpace_>(*rhs.parameter_space_);
   return *this;
 }
+
+template<int para_dim>
+typename Spline<para_dim>::SplitSides_
+Spline<para_dim>::SplitCoordinates(Dimension const& dimension,
+                                   Knot_ const& knot,
+                                   Coordinates_ const& coordinates,
+                                   Tolerance const& tolerance,
+                                   ExecutionPolicy_ const& execution_policy)
+    const {
+  using KnotVector = parameter_spaces::KnotVector;
+
+  ParameterSpace_ const& parameter_space = *parameter_space_;
+  const int i = dimension;
+  KnotVector const& knot_vector = *parameter_space.GetKnotVector(i);
+  if (knot - knot_vector.GetFront() <= tolerance
+      || knot_vector.GetBack() - knot <= tolerance) {
+    throw DomainError("Spline::Split - knot " + std::to_string(knot)
+                      + " has to lie in the interior of dimension "
+                      + std::to_string(i) + ".");
+  }
+
+  // knot insertion up to multiplicity p (C^0), a knot of multiplicity p+1
+  // already separates both sides
+  const int degree = parameter_space.GetDegree(i);
+  ParameterSpace_ fine{parameter_space};
+  typename ParameterSpace_::SparseMatrix_ prolongation;
+  const int number_of_insertions =
+      degree - knot_vector.DetermineMultiplicity(knot, tolerance);
+  if (number_of_insertions > 0) {
+    parameter_spaces::Refinement refinement;
+    refinement.knots_.assign(number_of_insertions, knot);
+    prolongation = fine.Refine(dimension, refinement, tolerance);
+  }
+
+  KnotVector const& fine_knot_vector = *fine.GetKnotVector(i);
+  const Knot_ *fine_knots_begin = fine_knot_vector.GetData(),
+              *fine_knots_end = fine_knots_begin + fine_knot_vector.GetSize();
+  const int first = static_cast<int>(
+      std::lower_bound(fine_knots_begin, fine_knots_end, knot - tolerance)
+      - fine_knots_begin);
+  const Knot_ split_knot = fine_knots_begin[first];
+  const int multiplicity = static_cast<int>(
+      std::upper_bound(fine_knots_begin,
+                       fine_knots_end,
+                       split_knot + tolerance)
+      - fine_knots_begin - first);
+  const int number_of_fine_basis_functions =
+      fine_knot_vector.GetSize() - degree - 1;
+
+  // [begin, end) of the basis functions and knots of each side
+  const Array<Array<int, 2>, 2> ranges{
+      Array<int, 2>{0, first},
+      Array<int, 2>{first + multiplicity - degree - 1,
+                    number_of_fine_basis_functions}};
+  auto const number_of_basis_functions =
+      parameter_space.GetNumberOfBasisFunctions();
+  Index number_of_inner_coordinates{1}, number_of_outer_coordinates{1};
+  for (int j{}; j < i; ++j) {
+    number_of_inner_coordinates *= number_of_basis_functions[j];
+  }
+  for (int j{i + 1}; j < para_dim; ++j) {
+    number_of_outer_coordinates *= number_of_basis_functions[j];
+  }
+  const int length = number_of_basis_functions[i],
+            dim = coordinates.Shape()[1];
+
+  SplitSides_ sides;
+  for (int side{}; side < 2; ++side) {
+    auto const& [begin, end] = ranges[side];
+    Knots_ knots(degree + 1, split_knot);
+    if (side == 0) {
+      knots.insert(knots.begin(),
+                   fine_knots_begin,
+                   fine_knots_begin + first);
+    } else {
+      knots.insert(knots.end(),
+                   fine_knots_begin + first + multiplicity,
+                   fine_knots_end);
+    }
+    typename ParameterSpace_::KnotVectors_ knot_vectors;
+    for (int j{}; j < para_dim; ++j) {
+      knot_vectors[j] =
+          (j == i) ? std::make_shared<KnotVector>(std::move(knots), tolerance)
+                   : std::make_shared<KnotVector>(
+                         *parameter_space.GetKnotVector(j));
+    }
+
+    const int new_length = end - begin;
+    Coordinates_ side_coordinates(number_of_inner_coordinates * new_length
+                                      * number_of_outer_coordinates,
+                                  dim);
+    side_coordinates.Fill(0.0);
+    // rows of all outer coordinates are independent of each other
+    utilities::parallel_operations::NThreadExecution(
+        [&](Index const& first_line, Index const& last_line) {
+          for (Index line{first_line}; line < last_line; ++line) {
+            const Index outer = line / new_length;
+            const int row = begin + static_cast<int>(line % new_length);
+            Type_* destination = &side_coordinates(
+                (outer * new_length + row - begin)
+                    * number_of_inner_coordinates,
+                0);
+            auto const add_line = [&](Index const& column,
+                                      Type_ const& factor) {
+              const Type_* source = &coordinates(
+                  (outer * length + column) * number_of_inner_coordinates,
+                  0);
+              for (Index k{}; k < number_of_inner_coordinates * dim; ++k) {
+                destination[k] += factor * source[k];
+              }
+            };
+            if (number_of_insertions > 0) {
+              for (Index k{prolongation.row_offsets_[row]};
+                   k < prolongation.row_offsets_[row + 1];
+                   ++k) {
+                add_line(prolongation.column_indices_[k],
+                         prolongation.values_[k]);
+              }
+            } else {
+              add_line(row, Type_{1.0});
+            }
+          }
+        },
+        number_of_outer_coordinates * new_length,
+        execution_policy);
+
+    sides[side] = {std::make_shared<ParameterSpace_>(std::move(knot_vectors),
+                                                     fine.GetDegrees()),
+                   std::move(side_coordinates)};
+  }
+  return sides;
+}
@@ -0,0 +1,184 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_SPLINES_STATIC_B_SPLINE_HPP_
+#define SOURCES_SPLINES_STATIC_B_SPLINE_HPP_
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/Utilities/named_type.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::splines {
+
+/// @brief StaticBSplines are B-splines whose shape, i.e., parametric
+/// dimensionality, degree, dimensionality, and number of basis functions per
+/// parametric dimension, is known at compile time.  Knots and coordinates are
+/// stored in std::arrays, evaluation is constexpr and involves neither heap
+/// allocations nor virtual calls, i.e., they are meant for huge numbers of
+/// tiny splines (e.g., particles or contact segments).  They can be converted
+/// from and to BSplines but cannot be refined.
+///
+/// Knots of all parametric dimensions are stored one after another.
+/// Coordinates are stored as array of structures with the first parametric
+/// dimension running fastest, i.e., the same way as BSpline's coordinates.
+/// Parametric coordinates outside of the parametric domain are evaluated on
+/// the first or last element.
+///
+/// Example (bicubic Bezier patch in 3D):
+///   using Patch = StaticBSpline<2, 3, 3, 4, 4>;
+///   constexpr Patch patch{knots, coordinates};
+///   Patch::Coordinate_ const &evaluated = patch.Evaluate({0.5, 0.5});
+///   SharedPointer<BSpline<2>> const &b_spline = patch.ToBSpline();
+///   Patch const patch_again{*b_spline};
+/// @tparam para_dim parametric dimensionality
+/// @tparam degree degree of all parametric dimensions
+/// @tparam dim dimensionality of the coordinates
+/// @tparam number_of_basis_functions one per parametric dimension
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+class StaticBSpline {
+  static_assert(para_dim > 0, "The parametric dimensionality must be positive");
+  static_assert(sizeof...(number_of_basis_functions) == para_dim,
+                "A number of basis functions is required per parametric "
+                "dimension.");
+  static_assert(degree >= 0, "The degree must not be negative.");
+  static_assert(dim > 0, "The dimensionality must be positive.");
+  static_assert(((number_of_basis_functions > degree) && ...),
+                "The number of basis functions must exceed the degree.");
+
+public:
+  using BSpline_ = BSpline<para_dim>;
+  using Type_ = Type;
+
+  static constexpr int kParaDim{para_dim};
+  static constexpr int kDegree{degree};
+  static constexpr int kDim{dim};
+  static constexpr int kNumberOfNonZeroBasisFunctionsPerDimension{degree + 1};
+  static constexpr Array<int, para_dim> kNumberOfBasisFunctions{
+      number_of_basis_functions...};
+  static constexpr int kNumberOfKnots{
+      (0 + ... + (number_of_basis_functions + degree + 1))};
+  static constexpr int kTotalNumberOfBasisFunctions{
+      (1 * ... * number_of_basis_functions)};
+  static constexpr int kNumberOfNonZeroBasisFunctions{
+      (1 * ... * (static_cast<void>(number_of_basis_functions), degree + 1))};
+
+  using Coordinate_ = Array<Type_, dim>;
+  using Coordinates_ = Array<Type_, kTotalNumberOfBasisFunctions * dim>;
+  using Knots_ = Array<Type_, kNumberOfKnots>;
+  using ParametricCoordinate_ = Array<Type_, para_dim>;
+  using BasisValues_ = Array<Type_, kNumberOfNonZeroBasisFunctions>;
+  using BasisValuesPerDimension_ =
+      Array<Array<Type_, kNumberOfNonZeroBasisFunctionsPerDimension>,
+            para_dim>;
+  using KnotSpans_ = Array<int, para_dim>;
+
+  constexpr StaticBSpline() = default;
+  /// @brief
+  /// @param knots knots of all parametric dimensions, one after another
+  /// @param coordinates (total number of basis functions x dim) array
+  constexpr StaticBSpline(Knots_ const& knots, Coordinates_ const& coordinates)
+      : knots_{knots},
+        coordinates_{coordinates} {}
+  /// @brief Copies knots and coordinates of the B-spline.  Throws if its shape
+  /// does not match.
+  /// @param b_spline
+  explicit StaticBSpline(BSpline_ const& b_spline);
+
+  /// @brief Creates a BSpline with copies of the knots and coordinates.
+  /// @param tolerance for the checks of the knot vectors
+  /// @return
+  SharedPointer<BSpline_>
+  ToBSpline(Tolerance const& tolerance = kEpsilon) const;
+
+  /// @brief Finds the span i of each parametric dimension with
+  /// u_i <= parametric coordinate < u_{i+1} (closed for the last element).
+  /// @param parametric_coordinate
+  /// @return
+  constexpr KnotSpans_
+  FindKnotSpans(ParametricCoordinate_ const& parametric_coordinate) const;
+  /// @brief Evaluates the p+1 non-zero basis functions of each parametric
+  /// dimension (see NURBS book A2.2).
+  /// @param parametric_coordinate
+  /// @param knot_spans see FindKnotSpans
+  /// @return
+  constexpr BasisValuesPerDimension_ EvaluateBasisValuesPerDimension(
+      ParametricCoordinate_ const& parametric_coordinate,
+      KnotSpans_ const& knot_spans) const;
+  /// @brief Evaluates the tensor products of the non-zero basis functions with
+  /// the first parametric dimension running fastest.
+  /// @param parametric_coordinate
+  /// @return
+  constexpr BasisValues_
+  EvaluateBasisValues(ParametricCoordinate_ const& parametric_coordinate) const;
+
+  /// @brief
+  /// @param parametric_coordinate
+  /// @return
+  constexpr Coordinate_
+  Evaluate(ParametricCoordinate_ const& parametric_coordinate) const;
+  /// @brief Evaluates the spline at many parametric coordinates.
+  /// @param parametric_coordinates (number_of_parametric_coordinates x
+  /// para_dim) array
+  /// @param number_of_parametric_coordinates
+  /// @param evaluated (number_of_parametric_coordinates x dim) array
+  constexpr void Evaluate(const Type_* parametric_coordinates,
+                          Index const& number_of_parametric_coordinates,
+                          Type_* evaluated) const;
+
+  constexpr Knots_ const& GetKnots() const { return knots_; }
+  constexpr Knots_& GetKnots() { return knots_; }
+  constexpr Coordinates_ const& GetCoordinates() const { return coordinates_; }
+  constexpr Coordinates_& GetCoordinates() { return coordinates_; }
+
+private:
+  // offset of each parametric dimension's first knot
+  static constexpr Array<int, para_dim> kKnotOffsets_{[] {
+    Array<int, para_dim> offsets{};
+    for (int i{1}; i < para_dim; ++i) {
+      offsets[i] = offsets[i - 1] + kNumberOfBasisFunctions[i - 1] + degree + 1;
+    }
+    return offsets;
+  }()};
+  // stride of each parametric dimension's basis functions
+  static constexpr Array<int, para_dim> kStrides_{[] {
+    Array<int, para_dim> strides{};
+    strides[0] = 1;
+    for (int i{1}; i < para_dim; ++i) {
+      strides[i] = strides[i - 1] * kNumberOfBasisFunctions[i - 1];
+    }
+    return strides;
+  }()};
+
+  Knots_ knots_{};
+  Coordinates_ coordinates_{};
+};
+
+#include "BSplineLib/Splines/static_b_spline.inl"
+
+} // namespace bsplinelib::splines
+
+#endif // SOURCES_SPLINES_STATIC_B_SPLINE_HPP_
@@ -0,0 +1,213 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::
+    StaticBSpline(BSpline_ const& b_spline) {
+  typename BSpline_::ParameterSpace_ const& parameter_space =
+      *b_spline.parameter_space_;
+  vector_spaces::VectorSpace const& vector_space = *b_spline.vector_space_;
+  auto const b_spline_number_of_basis_functions =
+      parameter_space.GetNumberOfBasisFunctions();
+  for (int i{}; i < para_dim; ++i) {
+    if (parameter_space.GetDegree(i) != degree
+        || b_spline_number_of_basis_functions[i]
+               != kNumberOfBasisFunctions[i]) {
+      throw InvalidArgument(
+          "StaticBSpline - parametric dimension " + std::to_string(i)
+          + " of the B-spline has degree "
+          + std::to_string(parameter_space.GetDegree(i)) + " and "
+          + std::to_string(b_spline_number_of_basis_functions[i])
+          + " basis functions instead of " + std::to_string(degree) + " and "
+          + std::to_string(kNumberOfBasisFunctions[i]) + ".");
+    }
+  }
+  if (vector_space.Dim() != dim) {
+    throw InvalidArgument("StaticBSpline - the B-spline's dimensionality is "
+                          + std::to_string(vector_space.Dim())
+                          + " instead of " + std::to_string(dim) + ".");
+  }
+
+  for (int i{}; i < para_dim; ++i) {
+    parameter_spaces::KnotVector const& knot_vector =
+        *parameter_space.GetKnotVector(i);
+    std::copy_n(knot_vector.GetData(),
+                knot_vector.GetSize(),
+                knots_.begin() + kKnotOffsets_[i]);
+  }
+  // layout-independent access
+  for (int i{}; i < kTotalNumberOfBasisFunctions; ++i) {
+    for (int j{}; j < dim; ++j) {
+      coordinates_[i * dim + j] = vector_space(i, j);
+    }
+  }
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+SharedPointer<BSpline<para_dim>>
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::ToBSpline(
+    Tolerance const& tolerance) const {
+  using KnotVector = parameter_spaces::KnotVector;
+  using ParameterSpace = typename BSpline_::ParameterSpace_;
+  using VectorSpace = vector_spaces::VectorSpace;
+
+  typename ParameterSpace::KnotVectors_ knot_vectors;
+  typename ParameterSpace::Degrees_ degrees;
+  for (int i{}; i < para_dim; ++i) {
+    auto const first = knots_.begin() + kKnotOffsets_[i];
+    knot_vectors[i] = std::make_shared<KnotVector>(
+        typename KnotVector::Knots_(
+            first,
+            first + kNumberOfBasisFunctions[i] + degree + 1),
+        tolerance);
+    degrees[i] = degree;
+  }
+  typename VectorSpace::Coordinates_ coordinates(kTotalNumberOfBasisFunctions,
+                                                 dim);
+  std::copy(coordinates_.begin(), coordinates_.end(), coordinates.begin());
+  return std::make_shared<BSpline_>(
+      std::make_shared<ParameterSpace>(std::move(knot_vectors),
+                                       std::move(degrees)),
+      std::make_shared<VectorSpace>(std::move(coordinates)));
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+constexpr auto
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::
+    FindKnotSpans(ParametricCoordinate_ const& parametric_coordinate) const
+    -> KnotSpans_ {
+  KnotSpans_ knot_spans{};
+  for (int i{}; i < para_dim; ++i) {
+    // number of interior knots u_{p+1}, ..., u_{n-1} not greater than the
+    // parametric coordinate (binary search)
+    const Type_* knots = &knots_[kKnotOffsets_[i]];
+    int first{degree + 1}, count{kNumberOfBasisFunctions[i] - degree - 1};
+    while (count > 0) {
+      const int step{count / 2};
+      if (!(parametric_coordinate[i] < knots[first + step])) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    knot_spans[i] = first - 1;
+  }
+  return knot_spans;
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+constexpr auto
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::
+    EvaluateBasisValuesPerDimension(
+        ParametricCoordinate_ const& parametric_coordinate,
+        KnotSpans_ const& knot_spans) const -> BasisValuesPerDimension_ {
+  BasisValuesPerDimension_ output{};
+  for (int i{}; i < para_dim; ++i) {
+    const Type_* knots = &knots_[kKnotOffsets_[i]];
+    Type_ const& u = parametric_coordinate[i];
+    int const& span = knot_spans[i];
+    auto& values = output[i];
+    Array<Type_, degree + 1> left{}, right{};
+
+    values[0] = Type_{1.0};
+    for (int k{1}; k <= degree; ++k) {
+      left[k] = u - knots[span + 1 - k];
+      right[k] = knots[span + k] - u;
+      Type_ saved{};
+      for (int j{}; j < k; ++j) {
+        const Type_ temp{values[j] / (right[j + 1] + left[k - j])};
+        values[j] = saved + right[j + 1] * temp;
+        saved = left[k - j] * temp;
+      }
+      values[k] = saved;
+    }
+  }
+  return output;
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+constexpr auto
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::
+    EvaluateBasisValues(ParametricCoordinate_ const& parametric_coordinate)
+        const -> BasisValues_ {
+  BasisValuesPerDimension_ const values_per_dimension{
+      EvaluateBasisValuesPerDimension(parametric_coordinate,
+                                      FindKnotSpans(parametric_coordinate))};
+  BasisValues_ values{};
+  for (int k{}; k < kNumberOfNonZeroBasisFunctions; ++k) {
+    Type_ value{1.0};
+    for (int i{}, rest{k}; i < para_dim; ++i) {
+      value *= values_per_dimension[i][rest % (degree + 1)];
+      rest /= degree + 1;
+    }
+    values[k] = value;
+  }
+  return values;
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+constexpr auto
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::
+    Evaluate(ParametricCoordinate_ const& parametric_coordinate) const
+    -> Coordinate_ {
+  KnotSpans_ const knot_spans{FindKnotSpans(parametric_coordinate)};
+  BasisValuesPerDimension_ const values_per_dimension{
+      EvaluateBasisValuesPerDimension(parametric_coordinate, knot_spans)};
+  int first{};
+  for (int i{}; i < para_dim; ++i) {
+    first += (knot_spans[i] - degree) * kStrides_[i];
+  }
+
+  // non-zero basis functions with the first parametric dimension running
+  // fastest, the loops are unrolled for small degrees
+  Coordinate_ evaluated{};
+  for (int k{}; k < kNumberOfNonZeroBasisFunctions; ++k) {
+    Type_ value{1.0};
+    int coordinate{first};
+    for (int i{}, rest{k}; i < para_dim; ++i) {
+      const int local{rest % (degree + 1)};
+      value *= values_per_dimension[i][local];
+      coordinate += local * kStrides_[i];
+      rest /= degree + 1;
+    }
+    for (int j{}; j < dim; ++j) {
+      evaluated[j] += value * coordinates_[coordinate * dim + j];
+    }
+  }
+  return evaluated;
+}
+
+template<int para_dim, int degree, int dim, int... number_of_basis_functions>
+constexpr void
+StaticBSpline<para_dim, degree, dim, number_of_basis_functions...>::Evaluate(
+    const Type_* parametric_coordinates,
+    Index const& number_of_parametric_coordinates,
+    Type_* evaluated) const {
+  for (Index i{}; i < number_of_parametric_coordinates; ++i) {
+    ParametricCoordinate_ parametric_coordinate{};
+    for (int j{}; j < para_dim; ++j) {
+      parametric_coordinate[j] = parametric_coordinates[i * para_dim + j];
+    }
+    Coordinate_ const coordinate{Evaluate(parametric_coordinate)};
+    for (int j{}; j < dim; ++j) {
+      evaluated[i * dim + j] = coordinate[j];
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_SPLINES_VERSIONED_SPLINE_HPP_
+#define SOURCES_SPLINES_VERSIONED_SPLINE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+
+namespace bsplinelib::splines {
+
+/// @brief VersionedSplines let many threads evaluate a spline while another
+/// thread refines it. Readers pin the current version, an immutable snapshot,
+/// and keep using it for as long as they hold it. Writers modify a copy of the
+/// current version and publish it atomically, i.e., readers do not wait for
+/// a modification to finish and never see a partially refined spline. A
+/// version is reclaimed as soon as it is neither current nor pinned.
+///
+/// Pinning and publishing are not lock-free though. Both std::atomic of
+/// SharedPointer and the std::atomic_load_explicit fallback use an internal
+/// lock in libstdc++ (a global mutex pool for the latter), which is held for
+/// the duration of a pointer copy. Readers may thus briefly wait for each
+/// other or for a writer storing a version, but not for a modification.
+///
+/// Copies of BSplines and Nurbs share their knots and coordinates until
+/// modified (see KnotVector and VectorSpace), so a modification only copies
+/// what it actually changes.
+///
+/// Example:
+///   VersionedSpline<BSpline<2>> versioned{b_spline};
+///   // reader threads
+///   auto const snapshot = versioned.Pin();
+///   snapshot->spline_->Evaluate(parametric_coordinate, evaluated);
+///   // writer thread
+///   versioned.Modify([](BSpline<2>& spline) {
+///     spline.InsertKnot(Dimension{0}, 0.5);
+///   });
+/// @tparam SplineType spline whose copy constructor copies by value, e.g.,
+/// BSpline or Nurbs
+template<typename SplineType>
+class VersionedSpline {
+public:
+  using Spline_ = SplineType;
+  using Version_ = std::uint64_t;
+  using Modification_ = std::function<void(Spline_&)>;
+
+  /// @brief Immutable version of the spline.
+  struct Snapshot_ {
+    SharedPointer<Spline_ const> spline_;
+    Version_ version_;
+  };
+  using SnapshotPointer_ = SharedPointer<Snapshot_ const>;
+
+  /// @brief Publishes given spline as version 0. It must not be modified
+  /// afterwards.
+  /// @param spline
+  explicit VersionedSpline(SharedPointer<Spline_ const> spline);
+  VersionedSpline(VersionedSpline const& other) = delete;
+  VersionedSpline(VersionedSpline&& other) noexcept = delete;
+  VersionedSpline& operator=(VersionedSpline const& rhs) = delete;
+  VersionedSpline& operator=(VersionedSpline&& rhs) noexcept = delete;
+  virtual ~VersionedSpline() = default;
+
+  /// @brief Pins the current version. It stays valid (and unchanged) until the
+  /// returned pointer is released, independent of later modifications.
+  /// @return
+  SnapshotPointer_ Pin() const;
+
+  /// @brief Number of the current version.
+  /// @return
+  Version_ GetVersion() const;
+
+  /// @brief Publishes given spline as the next version. It must not be
+  /// modified afterwards.
+  /// @param spline
+  /// @return number of the published version
+  Version_ Publish(SharedPointer<Spline_ const> spline);
+
+  /// @brief Applies the modification to a copy of the current version and
+  /// publishes the result. Writers are serialized. If the modification
+  /// throws, nothing is published.
+  /// @param modification
+  /// @return number of the published version
+  Version_ Modify(Modification_ const& modification);
+
+private:
+  // Serializes writers, i.e., Modify cannot lose a concurrent Publish.
+  std::mutex writer_mutex_;
+  // Neither storage is lock-free (see the class comment).
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::atomic<SnapshotPointer_> current_;
+#else
+  SnapshotPointer_ current_;
+#endif
+
+  // Requires writer_mutex_ to be locked by the caller.
+  Version_ PublishLocked(SharedPointer<Spline_ const> spline);
+  // Atomically replaces the current version.
+  void Store(SnapshotPointer_ snapshot);
+};
+
+#include "BSplineLib/Splines/versioned_spline.inl"
+
+} // namespace bsplinelib::splines
+
+#endif // SOURCES_SPLINES_VERSIONED_SPLINE_HPP_
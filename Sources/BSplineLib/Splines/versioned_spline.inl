@@ -0,0 +1,84 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<typename SplineType>
+VersionedSpline<SplineType>::VersionedSpline(
+    SharedPointer<Spline_ const> spline) {
+  if (!spline) {
+    throw InvalidArgument("VersionedSpline - spline must not be empty.");
+  }
+  Store(std::make_shared<Snapshot_ const>(Snapshot_{std::move(spline), 0}));
+}
+
+template<typename SplineType>
+typename VersionedSpline<SplineType>::SnapshotPointer_
+VersionedSpline<SplineType>::Pin() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+  return current_.load(std::memory_order_acquire);
+#else
+  return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+#endif
+}
+
+template<typename SplineType>
+typename VersionedSpline<SplineType>::Version_
+VersionedSpline<SplineType>::GetVersion() const {
+  return Pin()->version_;
+}
+
+template<typename SplineType>
+typename VersionedSpline<SplineType>::Version_
+VersionedSpline<SplineType>::Publish(SharedPointer<Spline_ const> spline) {
+  if (!spline) {
+    throw InvalidArgument(
+        "VersionedSpline::Publish - spline must not be empty.");
+  }
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  return PublishLocked(std::move(spline));
+}
+
+template<typename SplineType>
+typename VersionedSpline<SplineType>::Version_
+VersionedSpline<SplineType>::Modify(Modification_ const& modification) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  SharedPointer<Spline_> spline{std::make_shared<Spline_>(*Pin()->spline_)};
+  modification(*spline);
+  return PublishLocked(std::move(spline));
+}
+
+template<typename SplineType>
+typename VersionedSpline<SplineType>::Version_
+VersionedSpline<SplineType>::PublishLocked(
+    SharedPointer<Spline_ const> spline) {
+  Version_ const version{Pin()->version_ + 1};
+  Store(std::make_shared<Snapshot_ const>(
+      Snapshot_{std::move(spline), version}));
+  return version;
+}
+
+template<typename SplineType>
+void VersionedSpline<SplineType>::Store(SnapshotPointer_ snapshot) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+  current_.store(std::move(snapshot), std::memory_order_release);
+#else
+  std::atomic_store_explicit(&current_,
+                             std::move(snapshot),
+                             std::memory_order_release);
+#endif
+}
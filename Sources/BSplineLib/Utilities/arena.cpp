@@ -0,0 +1,85 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "BSplineLib/Utilities/arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "BSplineLib/Utilities/error_handling.hpp"
+
+namespace bsplinelib::utilities {
+
+Arena::Arena(std::size_t const& block_size) : block_size_{block_size} {}
+
+void* Arena::Allocate(std::size_t const& number_of_bytes,
+                      std::size_t const& alignment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const padding = [&] {
+    return (alignment - reinterpret_cast<std::uintptr_t>(free_) % alignment)
+           % alignment;
+  };
+  if (!free_ || padding() + number_of_bytes > number_of_free_bytes_) {
+    // new blocks are aligned for any fundamental type (operator new[]), over-
+    // aligned types may need additional padding
+    std::size_t const size =
+        std::max(block_size_, number_of_bytes + alignment);
+    blocks_.emplace_back(new std::byte[size]);
+    number_of_reserved_bytes_ += size;
+    free_ = blocks_.back().get();
+    number_of_free_bytes_ = size;
+  }
+  std::size_t const offset = padding();
+  std::byte* memory = free_ + offset;
+  free_ = memory + number_of_bytes;
+  number_of_free_bytes_ -= offset + number_of_bytes;
+  ++number_of_live_allocations_;
+  return memory;
+}
+
+void Arena::Deallocate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  --number_of_live_allocations_;
+}
+
+void Arena::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (number_of_live_allocations_ != 0) {
+    throw RuntimeError("Arena::Release - "
+                       + std::to_string(number_of_live_allocations_)
+                       + " allocations are still alive.");
+  }
+  blocks_.clear();
+  number_of_reserved_bytes_ = 0;
+  free_ = nullptr;
+  number_of_free_bytes_ = 0;
+}
+
+std::size_t Arena::GetNumberOfReservedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_reserved_bytes_;
+}
+
+std::size_t Arena::GetNumberOfLiveAllocations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_live_allocations_;
+}
+
+} // namespace bsplinelib::utilities
@@ -0,0 +1,153 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_UTILITIES_ARENA_HPP_
+#define SOURCES_UTILITIES_ARENA_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "BSplineLib/Utilities/containers.hpp"
+
+namespace bsplinelib::utilities {
+
+// Arenas hand out memory from large blocks and release all of it at once, e.g.,
+// for the many small objects of a model read from a file.  Individual
+// deallocations only count the allocations that are still alive.  Thread-safe.
+//
+// Objects created with MakeShared (or std::allocate_shared and an
+// ArenaAllocator) keep their arena alive, i.e., the arena's memory is released
+// together with the last of its objects unless Release is called explicitly
+// beforehand.  Only the objects themselves and their control blocks come from
+// the arena.  Buffers they allocate internally, e.g., knots, coordinates and
+// weights, are taken from the heap.
+//
+// Example:
+//   auto const arena = std::make_shared<Arena>();
+//   // Control block and knot vector share a single allocation from the arena.
+//   SharedPointer<KnotVector> knot_vector =
+//       MakeShared<KnotVector>(arena, knots);
+//   knot_vector.reset();
+//   arena->Release();  // Returns all blocks to the system.
+class Arena {
+public:
+  static constexpr std::size_t kDefaultBlockSize{1 << 16};
+
+  explicit Arena(std::size_t const& block_size = kDefaultBlockSize);
+  Arena(Arena const& other) = delete;
+  Arena(Arena&& other) noexcept = delete;
+  Arena& operator=(Arena const& rhs) = delete;
+  Arena& operator=(Arena&& rhs) noexcept = delete;
+  virtual ~Arena() = default;
+
+  /// @brief Uninitialized memory that stays valid until the arena is
+  /// destroyed. Requests larger than the block size get a block of their own.
+  /// @param number_of_bytes
+  /// @param alignment power of two
+  /// @return
+  void* Allocate(std::size_t const& number_of_bytes,
+                 std::size_t const& alignment);
+
+  /// @brief Marks an allocation as dead.  Its memory is not reused.
+  void Deallocate();
+
+  /// @brief Returns all blocks to the system, e.g., once all splines of a
+  /// model are destroyed, and lets the arena start over.
+  /// @throws RuntimeError if allocations are still alive
+  void Release();
+
+  /// @brief Number of bytes of all blocks requested from the system since the
+  /// last release.
+  /// @return
+  std::size_t GetNumberOfReservedBytes() const;
+  /// @brief
+  /// @return number of allocations that have not been deallocated yet
+  std::size_t GetNumberOfLiveAllocations() const;
+
+private:
+  std::size_t block_size_;
+  mutable std::mutex mutex_;
+  Vector<UniquePointer<std::byte[]>> blocks_;
+  std::size_t number_of_reserved_bytes_{};
+  std::size_t number_of_live_allocations_{};
+  // Unused part of the last block.
+  std::byte* free_{};
+  std::size_t number_of_free_bytes_{};
+};
+
+// Allocators that take their memory from an arena, e.g., for
+// std::allocate_shared.
+template<typename Type>
+class ArenaAllocator {
+public:
+  using value_type = Type;
+
+  explicit ArenaAllocator(SharedPointer<Arena> arena) noexcept
+      : arena_{std::move(arena)} {}
+  template<typename U>
+  ArenaAllocator(ArenaAllocator<U> const& other) noexcept
+      : arena_{other.GetArena()} {}
+
+  /// @brief Allocates uninitialized memory for n objects
+  /// @param n
+  /// @return
+  Type* allocate(std::size_t const& n) const {
+    return static_cast<Type*>(
+        arena_->Allocate(n * sizeof(Type), alignof(Type)));
+  }
+  /// @brief Memory is released together with the arena.
+  void deallocate(Type*, std::size_t const&) const noexcept {
+    arena_->Deallocate();
+  }
+
+  SharedPointer<Arena> const& GetArena() const { return arena_; }
+
+  template<typename U>
+  bool operator==(ArenaAllocator<U> const& rhs) const {
+    return arena_ == rhs.GetArena();
+  }
+  template<typename U>
+  bool operator!=(ArenaAllocator<U> const& rhs) const {
+    return !(*this == rhs);
+  }
+
+private:
+  SharedPointer<Arena> arena_;
+};
+
+/// @brief Creates the object in a single allocation from the arena or, if
+/// there is none, from the heap (std::make_shared).
+/// @param arena may be empty
+/// @param arguments
+/// @return
+template<typename Type, typename... Arguments>
+SharedPointer<Type> MakeShared(SharedPointer<Arena> const& arena,
+                               Arguments&&... arguments) {
+  if (!arena) {
+    return std::make_shared<Type>(std::forward<Arguments>(arguments)...);
+  }
+  return std::allocate_shared<Type>(ArenaAllocator<Type>{arena},
+                                    std::forward<Arguments>(arguments)...);
+}
+
+} // namespace bsplinelib::utilities
+
+#endif // SOURCES_UTILITIES_ARENA_HPP_
@@ -24,9 +24,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <new>
 #include <numeric>
 #include <tuple>
 #include <type_traits>
@@ -36,6 +38,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Utilities/error_handling.hpp"
 #include "BSplineLib/Utilities/named_type.hpp"
 #include "BSplineLib/Utilities/numeric_operations.hpp"
+#include "BSplineLib/Utilities/system_operations.hpp"
 
 namespace bsplinelib {
 
@@ -171,12 +174,98 @@ template<typename ContainerType>
 constexpr typename ContainerType::value_type
 EuclidianDistance(ContainerType const& lhs, ContainerType const& rhs);
 
+// Fused kernels on n contiguous values, e.g., coordinates of lines of control
+// points.  Unlike the container operations above, they neither allocate
+// temporaries nor check sizes and the result may alias any input.  Products are
+// formed and summed in Accumulation before being rounded to Type.
+//
+// Example:
+//   Axpby(alpha, upper, 1.0 - alpha, lower, dim, lower);  // Convex combination
+//   of two coordinates in place as used by knot insertion.
+template<typename Type>
+constexpr void Axpby(Type const& a,
+                     const Type* x,
+                     Type const& b,
+                     const Type* y,
+                     int const& n,
+                     Type* result);
+template<typename Type>
+constexpr void Axpy(Type const& a, const Type* x, int const& n, Type* y);
+template<typename Type>
+constexpr void Scale(Type const& a, int const& n, Type* x);
+template<typename Type>
+constexpr Type SquaredDistance(const Type* x, const Type* y, int const& n);
+
 #ifndef NDEBUG
 template<typename ContainerTypeLhs, typename ContainerTypeRhs>
 void ThrowIfContainerSizesDiffer(ContainerTypeLhs const& lhs,
                                  ContainerTypeRhs const& rhs);
 #endif
 
+/// @brief Default alignment of Data, i.e., a cache line, which also suits SIMD
+/// loads of up to 512 bits.
+constexpr std::size_t kDataAlignment{64};
+/// @brief Size of (transparent) huge pages. Smaller allocations are not
+/// backed by huge pages.
+constexpr std::size_t kHugePageSize{std::size_t{1} << 21};
+
+/// @brief Allocator of aligned, uninitialized memory. If requested,
+/// allocations of at least kHugePageSize bytes are aligned to and backed by
+/// huge pages where the system supports it, which reduces TLB misses when
+/// traversing large arrays.
+/// @tparam Type
+/// @tparam alignment power of two
+/// @tparam use_huge_pages
+template<typename Type,
+         std::size_t alignment = kDataAlignment,
+         bool use_huge_pages = false>
+class AlignedAllocator {
+  static_assert((alignment & (alignment - 1)) == 0
+                    && alignment >= alignof(Type),
+                "alignment needs to be a power of two and at least the "
+                "alignment of Type.");
+
+public:
+  using value_type = Type;
+
+  template<typename U>
+  /// @brief Rebind
+  struct rebind {
+    using other = AlignedAllocator<U, alignment, use_huge_pages>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+  template<typename U>
+  constexpr AlignedAllocator(
+      AlignedAllocator<U, alignment, use_huge_pages> const&) noexcept {}
+
+  /// @brief Allocates uninitialized memory for n objects
+  /// @param n
+  /// @return
+  Type* allocate(std::size_t const& n) const;
+  /// @brief Frees memory allocated for n objects
+  /// @param memory
+  /// @param n
+  void deallocate(Type* memory, std::size_t const& n) const noexcept;
+
+  template<typename U>
+  constexpr bool
+  operator==(AlignedAllocator<U, alignment, use_huge_pages> const&) const {
+    return true;
+  }
+  template<typename U>
+  constexpr bool
+  operator!=(AlignedAllocator<U, alignment, use_huge_pages> const&) const {
+    return false;
+  }
+
+private:
+  // Huge pages require allocations to be aligned to and padded to whole pages.
+  static constexpr bool UsesHugePages(std::size_t const& n);
+  static constexpr std::size_t DetermineAlignment(std::size_t const& n);
+  static constexpr std::size_t DetermineNumberOfBytes(std::size_t const& n);
+};
+
 /// @brief lightweight self deleting array. Meant to be used for simple tasks,
 /// where you want to avoid value initialization of every element, unlike
 /// std::vector does.
@@ -184,10 +273,22 @@ void ThrowIfContainerSizesDiffer(ContainerTypeLhs const& lhs,
 template<typename T>
 struct TemporaryData {
   T* data_;
-  TemporaryData(const int n) : data_(new T[n]) {}
-  ~TemporaryData() { delete[] data_; }
-  constexpr T& operator[](const int& i) { return data_[i]; }
-  constexpr const T& operator[](const int& i) const { return data_[i]; }
+  bsplinelib::Index size_;
+  TemporaryData(const bsplinelib::Index n)
+      : data_(AlignedAllocator<T>{}.allocate(n)),
+        size_(n) {
+    std::uninitialized_default_construct_n(data_, size_);
+  }
+  TemporaryData(TemporaryData const& other) = delete;
+  TemporaryData& operator=(TemporaryData const& rhs) = delete;
+  ~TemporaryData() {
+    std::destroy_n(data_, size_);
+    AlignedAllocator<T>{}.deallocate(data_, size_);
+  }
+  constexpr T& operator[](const bsplinelib::Index& i) { return data_[i]; }
+  constexpr const T& operator[](const bsplinelib::Index& i) const {
+    return data_[i];
+  }
 };
 
 /// @brief lightweight self deleting 2D array. Meant to be used for simple
@@ -198,25 +299,49 @@ template<typename T>
 struct TemporaryData2D {
   T* data_;
   int dim_;
-  TemporaryData2D(const int n, const int d) : data_(new T[n * d]), dim_(d) {}
-  ~TemporaryData2D() { delete[] data_; }
-  constexpr T& operator()(const int& i, const int& j) {
+  bsplinelib::Index size_;
+  TemporaryData2D(const bsplinelib::Index n, const int d)
+      : data_(AlignedAllocator<T>{}.allocate(n * d)),
+        dim_(d),
+        size_(n * d) {
+    std::uninitialized_default_construct_n(data_, size_);
+  }
+  TemporaryData2D(TemporaryData2D const& other) = delete;
+  TemporaryData2D& operator=(TemporaryData2D const& rhs) = delete;
+  ~TemporaryData2D() {
+    std::destroy_n(data_, size_);
+    AlignedAllocator<T>{}.deallocate(data_, size_);
+  }
+  constexpr T& operator()(const bsplinelib::Index& i, const int& j) {
     return data_[i * dim_ + j];
   }
-  constexpr const T& operator()(const int& i, const int& j) const {
+  constexpr const T& operator()(const bsplinelib::Index& i,
+                                const int& j) const {
     return data_[i * dim_ + j];
   }
 };
 
 /// @brief Fully dynamic array that can view another data. Equipped with basic
-/// math operations.
+/// math operations. Owned data is allocated by the allocator, i.e., aligned to
+/// kDataAlignment by default.
 /// @tparam DataType
 /// @tparam dim
-template<typename DataType, int dim = 1, typename IndexType = int>
+/// @tparam IndexType
+/// @tparam Allocator allocator of std::remove_const_t<DataType>
+template<typename DataType,
+         int dim = 1,
+         typename IndexType = bsplinelib::Index,
+         typename Allocator = AlignedAllocator<std::remove_const_t<DataType>>>
 class Data {
   static_assert(dim > 0, "dim needs to be positive value bigger than zero.");
   static_assert(std::is_integral_v<IndexType>,
                 "IndexType should be an integral type");
+  static_assert(std::is_same_v<typename Allocator::value_type,
+                               std::remove_const_t<DataType>>,
+                "Allocator should allocate DataType");
+
+  using StorageType_ = std::remove_const_t<DataType>;
+  using AllocatorTraits_ = std::allocator_traits<Allocator>;
 
 public:
   using ShapeType_ = std::array<IndexType, dim>;
@@ -226,9 +351,12 @@ public:
   using DataType_ = DataType;
   using IndexType_ = IndexType;
 
+  using Allocator_ = Allocator;
+
   // std container like types
   using value_type = DataType;
   using size_type = IndexType;
+  using allocator_type = Allocator;
 
 protected:
   bool own_data_{false};
@@ -238,6 +366,12 @@ protected:
   /// @brief size of this Array
   IndexType size_{};
 
+  /// @brief number of allocated elements if data is owned. Unlike size_, it
+  /// is not changed by SetShape
+  IndexType capacity_{};
+
+  Allocator allocator_{};
+
   /// @brief strides in case this is a higher dim. last entry should be the same
   /// as size_
   StridesType_ strides_;
@@ -307,13 +441,20 @@ public:
 
   constexpr IndexType size() const { return size_; }
 
+  /// @brief false for views of other data
+  /// @return
+  constexpr bool OwnsData() const { return own_data_; }
+
   constexpr void DestroyData() {
     if (own_data_ && data_) {
-      delete[] data_;
+      StorageType_* storage = const_cast<StorageType_*>(data_);
+      std::destroy_n(storage, capacity_);
+      AllocatorTraits_::deallocate(allocator_, storage, capacity_);
     }
 
     data_ = nullptr;
     own_data_ = false;
+    capacity_ = 0;
   }
 
   constexpr void SetData(DataType* data_pointer) {
@@ -336,7 +477,11 @@ public:
   constexpr void Reallocate(const IndexType& size) {
     // destroy and reallocate space
     DestroyData();
-    data_ = new DataType[size];
+    StorageType_* storage = AllocatorTraits_::allocate(allocator_, size);
+    // default initialization, i.e., no initialization of arithmetic types
+    std::uninitialized_default_construct_n(storage, size);
+    data_ = storage;
+    capacity_ = size;
     own_data_ = true;
 
     // set size - don't forget to set shape in case this is multi-dim array
@@ -405,7 +550,10 @@ public:
 
   /// @brief copy ctor
   /// @param other
-  constexpr Data(const Data& other) {
+  constexpr Data(const Data& other)
+      : allocator_(
+          AllocatorTraits_::select_on_container_copy_construction(
+              other.allocator_)) {
     // memory alloc
     Reallocate(other.size_);
     // copy data
@@ -418,10 +566,11 @@ public:
 
   /// @brief move ctor
   /// @param other
-  constexpr Data(Data&& other) {
+  constexpr Data(Data&& other) : allocator_(std::move(other.allocator_)) {
     own_data_ = other.own_data_;
     data_ = std::move(other.data_);
     size_ = std::move(other.size_);
+    capacity_ = other.capacity_;
     strides_ = std::move(other.strides_);
     shape_ = std::move(other.shape_);
     other.own_data_ = false;
@@ -451,9 +600,11 @@ public:
   constexpr Data& operator=(Data&& rhs) {
     DestroyData();
 
+    allocator_ = std::move(rhs.allocator_);
     own_data_ = rhs.own_data_;
     data_ = std::move(rhs.data_);
     size_ = std::move(rhs.size_);
+    capacity_ = rhs.capacity_;
     strides_ = std::move(rhs.strides_);
     shape_ = std::move(rhs.shape_);
     rhs.own_data_ = false;
@@ -727,6 +878,140 @@ inline void Add(const DataType& a,
   }
 }
 
+/// @brief Sparse matrix in compressed sparse row (CSR) format. Column indices
+/// are sorted within each row.
+/// @tparam DataType
+/// @tparam IndexType
+template<typename DataType, typename IndexType = bsplinelib::Index>
+struct CompressedSparseRowMatrix {
+  IndexType number_of_rows_{};
+  IndexType number_of_columns_{};
+  /// @brief entries of row i are [row_offsets_[i], row_offsets_[i + 1])
+  Vector<IndexType> row_offsets_{IndexType{}};
+  Vector<IndexType> column_indices_;
+  Vector<DataType> values_;
+
+  constexpr IndexType GetNumberOfNonZeros() const {
+    return static_cast<IndexType>(values_.size());
+  }
+
+  /// @brief y = A x, where x and y are row-major with dim columns, e.g.,
+  /// coordinates.  Row sums are accumulated in Accumulation.
+  /// @param x
+  /// @param dim
+  /// @param y
+  void Multiply(const DataType* x, const int dim, DataType* y) const {
+    for (IndexType i{}; i < number_of_rows_; ++i) {
+      DataType* y_i = y + i * dim;
+      for (int j{}; j < dim; ++j) {
+        Accumulation sum{};
+        for (IndexType k{row_offsets_[i]}; k < row_offsets_[i + 1]; ++k) {
+          sum += static_cast<Accumulation>(values_[k])
+                 * x[column_indices_[k] * dim + j];
+        }
+        y_i[j] = static_cast<DataType>(sum);
+      }
+    }
+  }
+
+  /// @brief Returns A^T, e.g., a restriction operator for a prolongation.
+  /// @return
+  CompressedSparseRowMatrix Transpose() const {
+    CompressedSparseRowMatrix transpose;
+    transpose.number_of_rows_ = number_of_columns_;
+    transpose.number_of_columns_ = number_of_rows_;
+    transpose.row_offsets_.assign(number_of_columns_ + 1, IndexType{});
+    transpose.column_indices_.resize(column_indices_.size());
+    transpose.values_.resize(values_.size());
+
+    for (const IndexType& column : column_indices_) {
+      ++transpose.row_offsets_[column + 1];
+    }
+    std::partial_sum(transpose.row_offsets_.begin(),
+                     transpose.row_offsets_.end(),
+                     transpose.row_offsets_.begin());
+
+    // rows are visited in order, so columns of the transpose stay sorted
+    Vector<IndexType> positions(transpose.row_offsets_.begin(),
+                                std::prev(transpose.row_offsets_.end()));
+    for (IndexType i{}; i < number_of_rows_; ++i) {
+      for (IndexType k{row_offsets_[i]}; k < row_offsets_[i + 1]; ++k) {
+        IndexType& position = positions[column_indices_[k]];
+        transpose.column_indices_[position] = i;
+        transpose.values_[position] = values_[k];
+        ++position;
+      }
+    }
+
+    return transpose;
+  }
+};
+
+/// @brief Kronecker product A_{n-1} x ... x A_0 of sparse matrices. Row and
+/// column indices of the first factor run fastest, i.e., the same ordering as
+/// tensor product coefficients of splines.
+/// @tparam DataType
+/// @tparam IndexType
+/// @tparam n
+/// @param factors
+/// @return
+template<typename DataType, typename IndexType, std::size_t n>
+CompressedSparseRowMatrix<DataType, IndexType> KroneckerProduct(
+    Array<CompressedSparseRowMatrix<DataType, IndexType>, n> const& factors) {
+  using Entries = Vector<std::pair<IndexType, DataType>>;
+
+  CompressedSparseRowMatrix<DataType, IndexType> product;
+  Array<IndexType, n> column_strides;
+  std::size_t number_of_non_zeros{1};
+  product.number_of_rows_ = product.number_of_columns_ = IndexType{1};
+  for (std::size_t i{}; i < n; ++i) {
+    column_strides[i] = product.number_of_columns_;
+    product.number_of_rows_ *= factors[i].number_of_rows_;
+    product.number_of_columns_ *= factors[i].number_of_columns_;
+    number_of_non_zeros *= factors[i].values_.size();
+  }
+  product.row_offsets_.reserve(product.number_of_rows_ + 1);
+  product.column_indices_.reserve(number_of_non_zeros);
+  product.values_.reserve(number_of_non_zeros);
+
+  Array<IndexType, n> row{};
+  Entries entries, expanded_entries;
+  for (IndexType r{}; r < product.number_of_rows_; ++r) {
+    // expanding from the last factor keeps columns sorted
+    entries.assign(1, {IndexType{}, DataType{1}});
+    for (std::size_t i{n}; i-- > 0;) {
+      CompressedSparseRowMatrix<DataType, IndexType> const& factor =
+          factors[i];
+      expanded_entries.clear();
+      for (auto const& [column, value] : entries) {
+        for (IndexType k{factor.row_offsets_[row[i]]};
+             k < factor.row_offsets_[row[i] + 1];
+             ++k) {
+          expanded_entries.emplace_back(
+              column + factor.column_indices_[k] * column_strides[i],
+              value * factor.values_[k]);
+        }
+      }
+      std::swap(entries, expanded_entries);
+    }
+    for (auto const& [column, value] : entries) {
+      product.column_indices_.push_back(column);
+      product.values_.push_back(value);
+    }
+    product.row_offsets_.push_back(
+        static_cast<IndexType>(product.values_.size()));
+
+    for (std::size_t i{}; i < n; ++i) {
+      if (++row[i] < factors[i].number_of_rows_) {
+        break;
+      }
+      row[i] = IndexType{};
+    }
+  }
+
+  return product;
+}
+
 /// Adapted from a post from Casey
 /// http://stackoverflow.com/a/21028912/273767
 /// mentioned in `Note` at
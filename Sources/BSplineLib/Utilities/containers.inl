@@ -324,7 +324,91 @@ EuclidianDistance(ContainerType const& lhs, ContainerType const& rhs) {
             "EuclidianDistance");
     }
 #endif
-  return TwoNorm(Subtract(lhs, rhs));
+  return std::sqrt(
+      SquaredDistance(lhs.data(), rhs.data(), static_cast<int>(lhs.size())));
+}
+
+template<typename Type>
+constexpr void Axpby(Type const& a,
+                     const Type* x,
+                     Type const& b,
+                     const Type* y,
+                     int const& n,
+                     Type* result) {
+  for (int i{}; i < n; ++i) {
+    result[i] = static_cast<Type>(static_cast<Accumulation>(a) * x[i]
+                                  + static_cast<Accumulation>(b) * y[i]);
+  }
+}
+
+template<typename Type>
+constexpr void Axpy(Type const& a, const Type* x, int const& n, Type* y) {
+  for (int i{}; i < n; ++i) {
+    y[i] = static_cast<Type>(y[i] + static_cast<Accumulation>(a) * x[i]);
+  }
+}
+
+template<typename Type>
+constexpr void Scale(Type const& a, int const& n, Type* x) {
+  for (int i{}; i < n; ++i) {
+    x[i] *= a;
+  }
+}
+
+template<typename Type>
+constexpr Type SquaredDistance(const Type* x, const Type* y, int const& n) {
+  Accumulation squared_distance{};
+  for (int i{}; i < n; ++i) {
+    Accumulation const difference{static_cast<Accumulation>(x[i]) - y[i]};
+    squared_distance += difference * difference;
+  }
+  return static_cast<Type>(squared_distance);
+}
+
+template<typename Type, std::size_t alignment, bool use_huge_pages>
+Type* AlignedAllocator<Type, alignment, use_huge_pages>::allocate(
+    std::size_t const& n) const {
+  std::size_t const number_of_bytes{DetermineNumberOfBytes(n)};
+  void* memory{::operator new(number_of_bytes,
+                              std::align_val_t{DetermineAlignment(n)})};
+  if (UsesHugePages(n)) {
+    system_operations::AdviseHugePages(memory, number_of_bytes);
+  }
+  return static_cast<Type*>(memory);
+}
+
+template<typename Type, std::size_t alignment, bool use_huge_pages>
+void AlignedAllocator<Type, alignment, use_huge_pages>::deallocate(
+    Type* memory,
+    std::size_t const& n) const noexcept {
+  ::operator delete(memory,
+                    DetermineNumberOfBytes(n),
+                    std::align_val_t{DetermineAlignment(n)});
+}
+
+template<typename Type, std::size_t alignment, bool use_huge_pages>
+constexpr bool AlignedAllocator<Type, alignment, use_huge_pages>::UsesHugePages(
+    std::size_t const& n) {
+  return use_huge_pages && n * sizeof(Type) >= kHugePageSize;
+}
+
+template<typename Type, std::size_t alignment, bool use_huge_pages>
+constexpr std::size_t
+AlignedAllocator<Type, alignment, use_huge_pages>::DetermineAlignment(
+    std::size_t const& n) {
+  return UsesHugePages(n) ? std::max(alignment, kHugePageSize) : alignment;
+}
+
+template<typename Type, std::size_t alignment, bool use_huge_pages>
+constexpr std::size_t
+AlignedAllocator<Type, alignment, use_huge_pages>::DetermineNumberOfBytes(
+    std::size_t const& n) {
+  std::size_t const number_of_bytes{n * sizeof(Type)},
+      page_size{DetermineAlignment(n)};
+  if (!UsesHugePages(n)) {
+    return number_of_bytes;
+  }
+  return (number_of_bytes + page_size - 1) / page_size * page_size;
 }
 
 #ifndef NDEBUG
@@ -98,9 +98,10 @@ public:
   constexpr static Index Behind(const Length_& length);
   constexpr static Index Last(const Length_& length);
   constexpr static Index Before(const Length_& length);
-  constexpr static int GetIndex1d(const Length_& length, const Value_& value);
+  constexpr static Index_ GetIndex1d(const Length_& length,
+                                    const Value_& value);
 
-  constexpr int GetTotalNumberOfIndices() const;
+  constexpr Index_ GetTotalNumberOfIndices() const;
   constexpr Value_ GetIndex() const;
   constexpr Index_ GetIndex1d() const;
 
@@ -136,8 +137,8 @@ protected:
   }
 
 private:
-  constexpr int DetermineStride(Length_ const& length,
-                                Dimension const& dimension) const;
+  constexpr Index_ DetermineStride(Length_ const& length,
+                                   Dimension const& dimension) const;
 
 #ifndef NDEBUG
   static void ThrowIfValueIsInvalid(Length_ const& length, Value_ const& value);
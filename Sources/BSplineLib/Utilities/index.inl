@@ -113,8 +113,8 @@ constexpr Index<size>& Index<size>::operator--() {
     invalid_ = true;
   } else {
     for (Dimension dimension{}; dimension < size; ++dimension) {
-      int const& length = length_[dimension];
-      int& value = value_[dimension];
+      Length const& length = length_[dimension];
+      Index_& value = value_[dimension];
       if (length == 0) {
         continue;
       } else if (value == 0) {
@@ -134,8 +134,8 @@ Index<size>& Index<size>::Decrement(Dimension const& dimension) {
   Message const kName{"bsplinelib::utilities::Index::Decrement"};
   DimensionBoundCheck(kName, dimension);
 #endif
-  int const& length = length_[dimension];
-  int& value = value_[dimension];
+  Length const& length = length_[dimension];
+  Index_& value = value_[dimension];
   if (length != 0) {
     if (value == 0) {
       value = (length - 1);
@@ -216,7 +216,7 @@ constexpr Index<size> Index<size>::Last(const Length_& length) {
   Value_ value;
 
   auto v_iter = value.begin();
-  for (const int& len : length) {
+  for (const Length& len : length) {
     if (len != 0) {
       *v_iter = len - 1;
     } else {
@@ -239,12 +239,12 @@ constexpr Index<size> Index<size>::Before(const Length_& length) {
 }
 
 template<int size>
-constexpr int Index<size>::GetIndex1d(const Length_& length,
-                                      const Value_& value) {
+constexpr typename Index<size>::Index_
+Index<size>::GetIndex1d(const Length_& length, const Value_& value) {
   auto stride = [&length](const int& dim) {
-    int s{1};
+    Index_ s{1};
     for (int i{}; i < dim; ++i) {
-      const int len = length[i];
+      const Length len = length[i];
       if (len != 0) {
         s *= len;
       }
@@ -252,7 +252,7 @@ constexpr int Index<size>::GetIndex1d(const Length_& length,
     return s;
   };
 
-  int id{};
+  Index_ id{};
   for (int i{}; i < size; ++i) {
     id += value[i] * stride(i);
   }
@@ -260,7 +260,8 @@ constexpr int Index<size>::GetIndex1d(const Length_& length,
 }
 
 template<int size>
-constexpr int Index<size>::GetTotalNumberOfIndices() const {
+constexpr typename Index<size>::Index_
+Index<size>::GetTotalNumberOfIndices() const {
   return DetermineStride(length_, size);
 }
 
@@ -279,11 +280,12 @@ constexpr bsplinelib::Index Index<size>::GetIndex1d() const {
 }
 
 template<int size>
-constexpr int Index<size>::DetermineStride(Length_ const& length,
-                                           Dimension const& dimension) const {
-  int stride{1};
+constexpr typename Index<size>::Index_
+Index<size>::DetermineStride(Length_ const& length,
+                             Dimension const& dimension) const {
+  Index_ stride{1};
   for (int i{}; i < dimension; ++i) {
-    const int& len = length[i];
+    const Length& len = length[i];
     if (len != 0) {
       stride *= len;
     }
@@ -298,7 +300,7 @@ void Index<size>::ThrowIfValueIsInvalid(Length_ const& length,
                                         Value_ const& value) {
   for (int i{}; i < size; ++i) {
     Message const dimension_string{"for dimension " + std::to_string(i) + ": "};
-    if (value[i] < 0 || value[i] > std::max(0, length[i] - 1)) {
+    if (value[i] < 0 || value[i] > std::max(Length{}, length[i] - 1)) {
       throw OutOfRange(dimension_string);
     }
   }
@@ -19,32 +19,36 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "BSplineLib/Utilities/math_operations.hpp"
 
-// #include <cmath> // NOLINT(whitespace/comments)
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
 
 #include "BSplineLib/Utilities/error_handling.hpp"
 
 namespace bsplinelib::utilities::math_operations {
 
-int ComputeBinomialCoefficient(int const& number_of_elements_in_set,
-                               int const& number_of_elements_in_subset) {
+namespace {
+
 #ifndef NDEBUG
+void ThrowIfSubsetIsInvalid(int const& number_of_elements_in_set,
+                            int const& number_of_elements_in_subset,
+                            Message const& name) {
   using std::to_string;
 
-  Message const kName{"bsplinelib::utilities::math_operations::"
-                      "ComputeBinomialCoefficient"};
-
   if (number_of_elements_in_set < 0) {
     Throw(InvalidArgument("The number of elements in the set ("
                           + to_string(number_of_elements_in_set)
                           + ") must not "
                             "be negative."),
-          kName);
+          name);
   } else if (number_of_elements_in_subset < 0) {
     Throw(InvalidArgument("The number of elements in the subset ("
                           + to_string(number_of_elements_in_subset)
                           + ") must "
                             "not be negative."),
-          kName);
+          name);
   } else if (number_of_elements_in_subset > number_of_elements_in_set) {
     Throw(InvalidArgument(
               "The number of elements in the subset ("
@@ -52,27 +56,150 @@ int ComputeBinomialCoefficient(int const& number_of_elements_in_set,
               + ") must "
                 "not be greater than the number of elements in the set ("
               + to_string(number_of_elements_in_set) + ")."),
-          kName);
+          name);
+  }
+}
+#endif
+
+// Gaussian elimination with partial pivoting for any floating-point type.
+template<typename Type>
+void Solve(int const& n, int const& m, Type* matrix, Type* right_hand_sides) {
+  auto a = [&](int const& i, int const& j) -> Type& {
+    return matrix[i * n + j];
+  };
+  auto b = [&](int const& i, int const& j) -> Type& {
+    return right_hand_sides[i * m + j];
+  };
+
+  // forward elimination
+  for (int k{}; k < n; ++k) {
+    int pivot{k};
+    for (int i{k + 1}; i < n; ++i) {
+      if (std::abs(a(i, k)) > std::abs(a(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (a(pivot, k) == 0.0) {
+      Throw(RuntimeError("The matrix is singular."),
+            "bsplinelib::utilities::math_operations::SolveLinearSystem");
+    }
+    if (pivot != k) {
+      for (int j{k}; j < n; ++j) {
+        std::swap(a(k, j), a(pivot, j));
+      }
+      for (int j{}; j < m; ++j) {
+        std::swap(b(k, j), b(pivot, j));
+      }
+    }
+    for (int i{k + 1}; i < n; ++i) {
+      Type const factor{a(i, k) / a(k, k)};
+      if (factor == 0.0) {
+        continue;
+      }
+      for (int j{k + 1}; j < n; ++j) {
+        a(i, j) -= factor * a(k, j);
+      }
+      for (int j{}; j < m; ++j) {
+        b(i, j) -= factor * b(k, j);
+      }
+    }
+  }
+
+  // back substitution
+  for (int k{n - 1}; k >= 0; --k) {
+    for (int i{k + 1}; i < n; ++i) {
+      for (int j{}; j < m; ++j) {
+        b(k, j) -= a(k, i) * b(i, j);
+      }
+    }
+    for (int j{}; j < m; ++j) {
+      b(k, j) /= a(k, k);
+    }
   }
+}
+
+} // namespace
+
+int ComputeBinomialCoefficient(int const& number_of_elements_in_set,
+                               int const& number_of_elements_in_subset) {
+#ifndef NDEBUG
+  ThrowIfSubsetIsInvalid(number_of_elements_in_set,
+                         number_of_elements_in_subset,
+                         "bsplinelib::utilities::math_operations::"
+                         "ComputeBinomialCoefficient");
+#endif
+  return static_cast<int>(
+      std::round(DetermineBinomialCoefficient(number_of_elements_in_set,
+                                              number_of_elements_in_subset)));
+}
+
+double DetermineBinomialCoefficient(int const& number_of_elements_in_set,
+                                    int const& number_of_elements_in_subset) {
+#ifndef NDEBUG
+  ThrowIfSubsetIsInvalid(number_of_elements_in_set,
+                         number_of_elements_in_subset,
+                         "bsplinelib::utilities::math_operations::"
+                         "DetermineBinomialCoefficient");
 #endif
-  //  NOLINTNEXTLINE(whitespace/todo)
-  //  TODO(all): C++17 library cmath should provide std::beta (not yet
-  //  implemented). int const &number_of_elements_in_set_plus_1 =
-  //  (number_of_elements_in_set + 1); return (1 /
-  //  (number_of_elements_in_set_plus_1 *
-  //      std::beta(number_of_elements_in_set_plus_1 -
-  //      number_of_elements_in_subset, number_of_elements_in_subset + 1)));
-  if ((number_of_elements_in_subset == number_of_elements_in_set)
-      || (number_of_elements_in_subset == 0)) {
-    return 1;
-  } else {
-    int const& number_of_elements_in_set_minus_1 =
-        (number_of_elements_in_set - 1);
-    return (ComputeBinomialCoefficient(number_of_elements_in_set_minus_1,
-                                       number_of_elements_in_subset)
-            + ComputeBinomialCoefficient(number_of_elements_in_set_minus_1,
-                                         number_of_elements_in_subset - 1));
+  if (number_of_elements_in_set <= kMaximumTabulatedDegree) {
+    return kBinomialCoefficients[number_of_elements_in_set
+                                     * (number_of_elements_in_set + 1) / 2
+                                 + number_of_elements_in_subset];
+  }
+  // n choose k = prod_{i=1}^{k} (n - k + i) / i with k <= n - k
+  int const number_of_factors = std::min(
+      number_of_elements_in_subset,
+      number_of_elements_in_set - number_of_elements_in_subset);
+  double binomial_coefficient{1.0};
+  for (int i{1}; i <= number_of_factors; ++i) {
+    binomial_coefficient *= (number_of_elements_in_set - number_of_factors + i);
+    binomial_coefficient /= i;
+  }
+  return std::round(binomial_coefficient);
+}
+
+ElevationCoefficients const&
+DetermineElevationCoefficients(int const& degree, int const& multiplicity) {
+  static std::mutex mutex;
+  static std::map<std::pair<int, int>, ElevationCoefficients> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto const key = std::make_pair(degree, multiplicity);
+  if (auto const cached = cache.find(key); cached != cache.end()) {
+    return cached->second;
+  }
+
+  // Filled before insertion, i.e., an exception leaves the cache unchanged.
+  ElevationCoefficients coefficients;
+  int const& elevated_degree = (degree + multiplicity);
+  coefficients.reserve(std::max(elevated_degree - 1, 0));
+  for (int i{1}; i < elevated_degree; ++i) {
+    int const begin{std::max(0, i - multiplicity)},
+        end{std::min(degree, i) + 1};
+    double const inverse{1.0
+                         / DetermineBinomialCoefficient(elevated_degree, i)};
+    std::vector<double>& row = coefficients.emplace_back(end - begin);
+    for (int j{begin}; j < end; ++j) {
+      row[j - begin] = inverse
+                       * (DetermineBinomialCoefficient(degree, j)
+                          * DetermineBinomialCoefficient(multiplicity, i - j));
+    }
   }
+  return cache.emplace(key, std::move(coefficients)).first->second;
+}
+
+void SolveLinearSystem(int const& n,
+                       int const& m,
+                       double* matrix,
+                       double* right_hand_sides) {
+  Solve(n, m, matrix, right_hand_sides);
+}
+
+void SolveLinearSystem(int const& n,
+                       int const& m,
+                       float* matrix,
+                       float* right_hand_sides) {
+  Solve(n, m, matrix, right_hand_sides);
 }
 
 } // namespace bsplinelib::utilities::math_operations
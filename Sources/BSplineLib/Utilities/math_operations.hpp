@@ -20,17 +20,83 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #ifndef SOURCES_UTILITIES_MATH_OPERATIONS_HPP_
 #define SOURCES_UTILITIES_MATH_OPERATIONS_HPP_
 
+#include <array>
+#include <vector>
+
+// Binomial coefficients up to this number of elements in the set are
+// tabulated at compile time (e.g., set by CMake option
+// BSPLINELIB_MAXIMUM_TABULATED_DEGREE).
+#ifndef BSPLINELIB_MAXIMUM_TABULATED_DEGREE
+#define BSPLINELIB_MAXIMUM_TABULATED_DEGREE 32
+#endif
+
 // Math operations (that are not implemented by the standard library) such
-// as 1.) computing binomial coefficients.
+// as 1.) computing binomial coefficients, 2.) determining coefficients of
+// Bezier degree elevation, and 3.) solving small dense linear systems.
 //
 // Example:
 //   int const &four_choose_2 = ComputeBinomialCoefficient(4, 2);  // The
 //   binomial coefficient "4 choose 2" equals 6.
+//   double const &forty_choose_20 = DetermineBinomialCoefficient(40, 20);
+//   SolveLinearSystem(2, 1, matrix, right_hand_sides);  // Overwrites
+//   right_hand_sides with the solution.
 namespace bsplinelib::utilities::math_operations {
 
+using ElevationCoefficients = std::vector<std::vector<double>>;
+
+constexpr int const kMaximumTabulatedDegree{
+    BSPLINELIB_MAXIMUM_TABULATED_DEGREE};
+
+// Pascal's triangle stored row by row, i.e., "n choose k" is stored at
+// n * (n + 1) / 2 + k.
+constexpr std::array<double,
+                     (kMaximumTabulatedDegree + 1)
+                         * (kMaximumTabulatedDegree + 2) / 2>
+MakeBinomialCoefficients() {
+  std::array<double,
+             (kMaximumTabulatedDegree + 1) * (kMaximumTabulatedDegree + 2) / 2>
+      binomial_coefficients{};
+  for (int n{}; n <= kMaximumTabulatedDegree; ++n) {
+    int const row{n * (n + 1) / 2}, previous_row{(n - 1) * n / 2};
+    binomial_coefficients[row] = binomial_coefficients[row + n] = 1.0;
+    for (int k{1}; k < n; ++k) {
+      binomial_coefficients[row + k] =
+          binomial_coefficients[previous_row + k - 1]
+          + binomial_coefficients[previous_row + k];
+    }
+  }
+  return binomial_coefficients;
+}
+
+inline constexpr auto const kBinomialCoefficients = MakeBinomialCoefficients();
+
 int ComputeBinomialCoefficient(int const& number_of_elements_in_set,
                                int const& number_of_elements_in_subset);
 
+// Floating-point variant that does not overflow for large sets.  Tabulated
+// values are looked up, others are computed by the multiplicative formula.
+double DetermineBinomialCoefficient(int const& number_of_elements_in_set,
+                                    int const& number_of_elements_in_subset);
+
+// Coefficients of elevating the degree p of a Bezier curve by t, i.e., row i
+// (1 <= i < p+t) contains C(p, j) C(t, i-j) / C(p+t, i) for
+// max(0, i-t) <= j <= min(p, i).  Results are cached (thread-safe) and stay
+// valid for the lifetime of the program.
+ElevationCoefficients const&
+DetermineElevationCoefficients(int const& degree, int const& multiplicity);
+
+// Solves A X = B using Gaussian elimination with partial pivoting.  A is a
+// row-major (n x n) matrix that is overwritten by its factorization and B is a
+// row-major (n x m) matrix that is overwritten by X.
+void SolveLinearSystem(int const& n,
+                       int const& m,
+                       double* matrix,
+                       double* right_hand_sides);
+void SolveLinearSystem(int const& n,
+                       int const& m,
+                       float* matrix,
+                       float* right_hand_sides);
+
 } // namespace bsplinelib::utilities::math_operations
 
 #endif // SOURCES_UTILITIES_MATH_OPERATIONS_HPP_
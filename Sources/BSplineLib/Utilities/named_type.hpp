@@ -21,6 +21,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #define SOURCES_UTILITIES_NAMED_TYPE_HPP_
 
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <type_traits>
 #include <typeinfo>
@@ -29,6 +30,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #include "BSplineLib/Utilities/error_handling.hpp"
 #include "BSplineLib/Utilities/numeric_operations.hpp"
 
+// Scalar type of knots, coordinates and weights, e.g., float to halve the
+// memory traffic (e.g., set by CMake option BSPLINELIB_SCALAR_TYPE).
+#ifndef BSPLINELIB_SCALAR_TYPE
+#define BSPLINELIB_SCALAR_TYPE double
+#endif
+
+// Type in which evaluation and refinement kernels accumulate sums of products
+// of scalars, e.g., double to keep float control nets accurate (e.g., set by
+// CMake option BSPLINELIB_ACCUMULATION_TYPE).
+#ifndef BSPLINELIB_ACCUMULATION_TYPE
+#define BSPLINELIB_ACCUMULATION_TYPE double
+#endif
+
+// Type of indices and lengths, e.g., std::int64_t for control nets whose
+// number of coordinates times dimension exceeds the range of int (e.g., set by
+// CMake option BSPLINELIB_INDEX_TYPE).
+#ifndef BSPLINELIB_INDEX_TYPE
+#define BSPLINELIB_INDEX_TYPE int
+#endif
+
 namespace bsplinelib::utilities {
 
 template<typename Name, typename Type>
@@ -232,13 +253,13 @@ namespace bsplinelib {
 // using Index = utilities::NamedType<struct IndexName, int>;
 // using Length = utilities::NamedType<struct LengthName, int>;
 using Dimension = int;
-using Index = int;
-using Length = int;
+using Index = BSPLINELIB_INDEX_TYPE;
+using Length = Index;
+using Accumulation = BSPLINELIB_ACCUMULATION_TYPE;
 using Precision = utilities::NamedType<struct PrecisionName, int>;
 
 // parameter spaces
-// TODO: template param?
-using RealType__ = double;
+using RealType__ = BSPLINELIB_SCALAR_TYPE;
 using IntType__ = int;
 using Degree = IntType__;
 using Derivative = IntType__;
@@ -263,15 +284,15 @@ constexpr Tolerance const kEpsilon{
 } // namespace parameter_spaces
 
 // vector spaces
-using Coordinate = double;
+using Coordinate = RealType__;
 //    utilities::NamedType<struct CoordinateName, parameter_spaces::Type>;
-using Weight = double;
+using Weight = RealType__;
 // utilities::NamedType<struct WeightName, Coordinate::Type_>;
 
 namespace vector_spaces {
 
-using Type = double;      // Coordinate::Type_;
-using Tolerance = double; // Type;
+using Type = Coordinate; // Coordinate::Type_;
+using Tolerance = Type;
 
 constexpr Precision const kPrecision{
     utilities::numeric_operations::GetPrecision<Type>()};
@@ -0,0 +1,187 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "BSplineLib/Utilities/parallel_operations.hpp"
+
+#include <utility>
+
+namespace bsplinelib::utilities::parallel_operations {
+
+namespace {
+
+std::mutex default_execution_policy_mutex;
+ExecutionPolicy default_execution_policy{};
+
+} // namespace
+
+int DetermineNumberOfThreads(int const& number_of_threads) {
+  if (number_of_threads > 0) {
+    return number_of_threads;
+  }
+  // hardware_concurrency() may return 0 if it is not computable
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+ThreadPool::ThreadPool(int const& number_of_threads) {
+  int const number_of_workers{DetermineNumberOfThreads(number_of_threads) - 1};
+  workers_.reserve(number_of_workers);
+  for (int i{}; i < number_of_workers; ++i) {
+    workers_.emplace_back(&ThreadPool::Work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  job_available_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::GetNumberOfThreads() const {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void ThreadPool::Run(int const& number_of_tasks, Task_ const& task) {
+  if (number_of_tasks < 1) {
+    return;
+  }
+
+  SharedPointer<Job_> job{std::make_shared<Job_>()};
+  job->task_ = &task;
+  job->number_of_tasks_ = number_of_tasks;
+  if (!workers_.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(job);
+    }
+    job_available_.notify_all();
+  }
+  Process(*job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  job_finished_.wait(lock, [&] {
+    return job->number_of_finished_tasks_ == number_of_tasks;
+  });
+  std::exception_ptr const exception{job->exception_};
+  lock.unlock();
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::Work() {
+  while (true) {
+    SharedPointer<Job_> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_available_.wait(lock, [&] { return is_stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = jobs_.front();
+      // all tasks are claimed, the remaining ones are being processed
+      if (job->next_task_ >= job->number_of_tasks_) {
+        jobs_.pop_front();
+        continue;
+      }
+    }
+    Process(*job);
+  }
+}
+
+void ThreadPool::Process(Job_& job) {
+  for (int task{job.next_task_++}; task < job.number_of_tasks_;
+       task = job.next_task_++) {
+    try {
+      (*job.task_)(task);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!job.exception_) {
+        job.exception_ = std::current_exception();
+      }
+    }
+    if (++job.number_of_finished_tasks_ == job.number_of_tasks_) {
+      // locking ensures the notification cannot get lost
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      job_finished_.notify_all();
+    }
+  }
+}
+
+ExecutionPolicy::ExecutionPolicy(int const& number_of_threads)
+    : number_of_chunks_(DetermineNumberOfThreads(number_of_threads)) {}
+
+ExecutionPolicy::ExecutionPolicy(SharedPointer<ThreadPool> thread_pool,
+                                 int const& number_of_chunks)
+    : number_of_chunks_(number_of_chunks > 0
+                            ? number_of_chunks
+                            : thread_pool->GetNumberOfThreads()),
+      thread_pool_(std::move(thread_pool)) {}
+
+ExecutionPolicy::ExecutionPolicy(Executor_ executor,
+                                 int const& number_of_chunks)
+    : number_of_chunks_(DetermineNumberOfThreads(number_of_chunks)),
+      executor_(std::move(executor)) {}
+
+int ExecutionPolicy::GetNumberOfChunks() const { return number_of_chunks_; }
+
+void ExecutionPolicy::Execute(int const& number_of_tasks,
+                              Task_ const& task) const {
+  if (executor_) {
+    executor_(number_of_tasks, task);
+  } else if (thread_pool_) {
+    thread_pool_->Run(number_of_tasks, task);
+  } else {
+    Vector<std::thread> threads;
+    threads.reserve(std::max(number_of_tasks - 1, 0));
+    for (int i{1}; i < number_of_tasks; ++i) {
+      threads.emplace_back(task, i);
+    }
+    if (number_of_tasks > 0) {
+      task(0);
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+void SetDefaultExecutionPolicy(ExecutionPolicy execution_policy) {
+  std::lock_guard<std::mutex> lock(default_execution_policy_mutex);
+  default_execution_policy = std::move(execution_policy);
+}
+
+ExecutionPolicy GetDefaultExecutionPolicy() {
+  std::lock_guard<std::mutex> lock(default_execution_policy_mutex);
+  return default_execution_policy;
+}
+
+void SetDefaultNumberOfThreads(int const& number_of_threads) {
+  SetDefaultExecutionPolicy(ExecutionPolicy{number_of_threads});
+}
+
+int GetDefaultNumberOfThreads() {
+  return GetDefaultExecutionPolicy().GetNumberOfChunks();
+}
+
+} // namespace bsplinelib::utilities::parallel_operations
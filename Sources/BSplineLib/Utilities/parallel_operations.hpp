@@ -0,0 +1,147 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_UTILITIES_PARALLEL_OPERATIONS_HPP_
+#define SOURCES_UTILITIES_PARALLEL_OPERATIONS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/Utilities/named_type.hpp"
+
+// Parallel operations such as 1.) determining the number of threads to use and
+// 2.) executing a function on contiguous chunks of an index range according to
+// an execution policy.  Chunking is deterministic, i.e., it only depends on the
+// size of the range and the policy's number of chunks.
+//
+// Example:
+//   NThreadExecution([&](Index const& begin, Index const& end) {
+//     for (Index i{begin}; i < end; ++i) { output[i] = Compute(i); }
+//   }, 100, 4);  // Executes [0, 25), [25, 50), [50, 75) and [75, 100).
+//   int const &all = DetermineNumberOfThreads(0);  // Number of hardware
+//   threads.
+//   auto thread_pool = std::make_shared<ThreadPool>(8);
+//   NThreadExecution(function, 100, ExecutionPolicy{thread_pool});
+namespace bsplinelib::utilities::parallel_operations {
+
+// Non-positive requests use all available hardware threads.
+int DetermineNumberOfThreads(int const& number_of_threads);
+
+// Fixed set of worker threads that process the tasks of Run.  Idle workers
+// claim the next unprocessed task of the oldest job, i.e., load is balanced
+// dynamically.  The calling thread takes part in its job, so Run may be called
+// from within a task without deadlocking.
+class ThreadPool {
+public:
+  using Task_ = std::function<void(int const&)>;
+
+  // The number of threads includes the calling thread, i.e., n - 1 workers are
+  // started.  Non-positive requests use all available hardware threads.
+  explicit ThreadPool(int const& number_of_threads = 0);
+  ThreadPool(ThreadPool const& other) = delete;
+  ThreadPool(ThreadPool&& other) noexcept = delete;
+  ThreadPool& operator=(ThreadPool const& rhs) = delete;
+  ThreadPool& operator=(ThreadPool&& rhs) noexcept = delete;
+  ~ThreadPool();
+
+  int GetNumberOfThreads() const;
+
+  // Calls task(i) for i in [0, number_of_tasks) and returns once all of them
+  // are done.  The first exception thrown by a task is rethrown.
+  void Run(int const& number_of_tasks, Task_ const& task);
+
+private:
+  struct Job_ {
+    Task_ const* task_;
+    int number_of_tasks_;
+    std::atomic<int> next_task_{};
+    std::atomic<int> number_of_finished_tasks_{};
+    std::exception_ptr exception_;
+  };
+
+  void Work();
+  // Processes tasks of the job until all of them are claimed.
+  void Process(Job_& job);
+
+  std::mutex mutex_;
+  std::condition_variable job_available_, job_finished_;
+  std::deque<SharedPointer<Job_>> jobs_;
+  bool is_stopping_{false};
+  Vector<std::thread> workers_;
+};
+
+// Describes how chunks are executed: 1.) by the given number of threads, which
+// are started for each call, 2.) by a thread pool or 3.) by an executor, e.g.,
+// an adapter to an application's scheduler, that calls task(i) for i in
+// [0, number_of_tasks) and returns once all of them are done.
+class ExecutionPolicy {
+public:
+  using Task_ = std::function<void(int const&)>;
+  using Executor_ =
+      std::function<void(int const& number_of_tasks, Task_ const& task)>;
+
+  ExecutionPolicy() = default;
+  // Implicit, so that a number of threads can be passed wherever a policy is
+  // expected.  Non-positive requests use all available hardware threads.
+  ExecutionPolicy(int const& number_of_threads); // NOLINT
+  // Non-positive numbers of chunks use one chunk per thread of the pool.
+  explicit ExecutionPolicy(SharedPointer<ThreadPool> thread_pool,
+                           int const& number_of_chunks = 0);
+  // Non-positive numbers of chunks use one chunk per hardware thread.
+  ExecutionPolicy(Executor_ executor, int const& number_of_chunks);
+
+  int GetNumberOfChunks() const;
+
+  // Calls task(i) for i in [0, number_of_tasks).  Tasks must not throw.
+  void Execute(int const& number_of_tasks, Task_ const& task) const;
+
+private:
+  int number_of_chunks_{1};
+  SharedPointer<ThreadPool> thread_pool_;
+  Executor_ executor_;
+};
+
+// Policy used by operations unless one is passed, e.g., refinement of
+// splines.  Defaults to a single thread.
+void SetDefaultExecutionPolicy(ExecutionPolicy execution_policy);
+ExecutionPolicy GetDefaultExecutionPolicy();
+void SetDefaultNumberOfThreads(int const& number_of_threads);
+int GetDefaultNumberOfThreads();
+
+// Calls function(begin, end) for each chunk of [0, total), where begin and end
+// are Indices.  Exceptions thrown by any chunk are rethrown after all chunks
+// are done.
+template<typename Function>
+void NThreadExecution(Function const& function,
+                      bsplinelib::Index const& total,
+                      ExecutionPolicy const& execution_policy = {});
+
+#include "BSplineLib/Utilities/parallel_operations.inl"
+
+} // namespace bsplinelib::utilities::parallel_operations
+
+#endif // SOURCES_UTILITIES_PARALLEL_OPERATIONS_HPP_
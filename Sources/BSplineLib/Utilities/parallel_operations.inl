@@ -0,0 +1,58 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<typename Function>
+void NThreadExecution(Function const& function,
+                      bsplinelib::Index const& total,
+                      ExecutionPolicy const& execution_policy) {
+  using bsplinelib::Index;
+
+  if (total < 1) {
+    return;
+  }
+
+  int const n_chunks{static_cast<int>(
+      std::min(static_cast<Index>(execution_policy.GetNumberOfChunks()),
+               total))};
+  // no need to dispatch anything
+  if (n_chunks == 1) {
+    function(Index{}, total);
+    return;
+  }
+
+  Vector<std::exception_ptr> exceptions(n_chunks);
+  execution_policy.Execute(n_chunks, [&](int const& chunk) {
+    // balanced chunks - use long long to avoid overflow of total * chunk
+    Index const begin = static_cast<Index>(static_cast<long long>(total)
+                                           * chunk / n_chunks),
+                end = static_cast<Index>(static_cast<long long>(total)
+                                         * (chunk + 1) / n_chunks);
+    try {
+      function(begin, end);
+    } catch (...) {
+      exceptions[chunk] = std::current_exception();
+    }
+  });
+
+  for (std::exception_ptr const& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
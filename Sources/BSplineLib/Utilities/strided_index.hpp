@@ -0,0 +1,98 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#ifndef SOURCES_UTILITIES_STRIDED_INDEX_HPP_
+#define SOURCES_UTILITIES_STRIDED_INDEX_HPP_
+
+#include <string>
+
+#include "BSplineLib/Utilities/containers.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/Utilities/index.hpp"
+#include "BSplineLib/Utilities/named_type.hpp"
+
+namespace bsplinelib::utilities {
+
+// StridedIndices are lightweight odometers over size-dimensional (sub-)arrays
+// stored in column-major order.  Unlike Index, the strides are computed once
+// on construction and the one-dimensional index is updated incrementally, so
+// that GetIndex1d() is a mere load.  StridedIndices are trivially copyable and
+// do not check for overflows of the one-dimensional index.
+//
+// Example:
+//   using StridedIndex2d = StridedIndex<2>;
+//   Index<2> const origin{Index<2>::Length_{Length{5}, Length{4}},
+//                         Index<2>::Value_{Index{1}, Index{2}}};
+//   // 2x2 block of the 5x4 array starting at {1, 2}.
+//   StridedIndex2d index{StridedIndex2d::Length_{Length{2}, Length{2}},
+//                        origin};
+//   Index const &eleven = index.GetIndex1d();  // {1, 2} -> 1 + 2 * 5.
+//   index.Increment(Dimension{1});  // Moves to {1, 3}, i.e., 16.
+//   index.Increment(Dimension{1});  // Wraps around to {1, 2}, i.e., 11.
+//   ++index;  // Moves to {2, 2}, i.e., 12.
+template<int size>
+class StridedIndex {
+private:
+  template<typename Type>
+  using Array_ = Array<Type, size>;
+
+public:
+  using Index_ = bsplinelib::Index;
+  using Length_ = Array_<Length>;
+  using Stride_ = Array_<Index_>;
+  using Value_ = Array_<Index_>;
+
+  StridedIndex() = default;
+  /// @brief Iterates over all entries of an array of the given length.
+  explicit StridedIndex(Length_ const& length);
+  /// @brief Iterates over the block of the given length that starts at origin
+  /// within the array origin refers to.
+  StridedIndex(Length_ const& length, Index<size> const& origin);
+  StridedIndex(Length_ const& length,
+               Stride_ const& stride,
+               Index_ const& index_1d = Index_{});
+
+  constexpr StridedIndex& operator++();
+  StridedIndex& Increment(Dimension const& dimension);
+  StridedIndex& Decrement(Dimension const& dimension);
+
+  constexpr Index_ const& GetIndex1d() const { return index_1d_; }
+  constexpr Value_ const& GetValue() const { return value_; }
+  constexpr Length_ const& GetLength() const { return length_; }
+  constexpr Stride_ const& GetStride() const { return stride_; }
+  constexpr bool const& GetInvalid() const { return invalid_; }
+  constexpr Index_ GetTotalNumberOfIndices() const;
+
+private:
+  Length_ length_{};
+  Stride_ stride_{};
+  Value_ value_{};
+  Index_ index_1d_{};
+  bool invalid_{};
+
+#ifndef NDEBUG
+  static void ThrowIfDimensionIsInvalid(Dimension const& dimension);
+#endif
+};
+
+#include "BSplineLib/Utilities/strided_index.inl"
+
+} // namespace bsplinelib::utilities
+
+#endif // SOURCES_UTILITIES_STRIDED_INDEX_HPP_
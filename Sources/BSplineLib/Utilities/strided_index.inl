@@ -0,0 +1,129 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+template<int size>
+StridedIndex<size>::StridedIndex(Length_ const& length) : length_{length} {
+  Index_ stride{1};
+  for (int i{}; i < size; ++i) {
+    stride_[i] = stride;
+    if (length[i] != 0) {
+      stride *= length[i];
+    }
+  }
+}
+
+template<int size>
+StridedIndex<size>::StridedIndex(Length_ const& length,
+                                 Index<size> const& origin)
+    : StridedIndex(length,
+                   StridedIndex{origin.GetLength()}.GetStride(),
+                   origin.GetIndex1d()) {}
+
+template<int size>
+StridedIndex<size>::StridedIndex(Length_ const& length,
+                                 Stride_ const& stride,
+                                 Index_ const& index_1d)
+    : length_{length},
+      stride_{stride},
+      index_1d_{index_1d} {}
+
+template<int size>
+constexpr StridedIndex<size>& StridedIndex<size>::operator++() {
+  for (Dimension dimension{}; dimension < size; ++dimension) {
+    Length const& length = length_[dimension];
+    Index_& value = value_[dimension];
+    if (length == 0) {
+      continue;
+    } else if (value == (length - 1)) {
+      value = 0;
+      index_1d_ -= (length - 1) * stride_[dimension];
+    } else {
+      ++value;
+      index_1d_ += stride_[dimension];
+      return *this;
+    }
+  }
+  invalid_ = true; // Invalidate the index if it was incremented from the
+                   // maximum index.
+  return *this;
+}
+
+template<int size>
+StridedIndex<size>&
+StridedIndex<size>::Increment(Dimension const& dimension) {
+#ifndef NDEBUG
+  ThrowIfDimensionIsInvalid(dimension);
+#endif
+  Length const& length = length_[dimension];
+  Index_& value = value_[dimension];
+  if (length != 0) {
+    if (value == (length - 1)) {
+      value = 0;
+      index_1d_ -= (length - 1) * stride_[dimension];
+    } else {
+      ++value;
+      index_1d_ += stride_[dimension];
+    }
+  }
+  return *this;
+}
+
+template<int size>
+StridedIndex<size>&
+StridedIndex<size>::Decrement(Dimension const& dimension) {
+#ifndef NDEBUG
+  ThrowIfDimensionIsInvalid(dimension);
+#endif
+  Length const& length = length_[dimension];
+  Index_& value = value_[dimension];
+  if (length != 0) {
+    if (value == 0) {
+      value = (length - 1);
+      index_1d_ += (length - 1) * stride_[dimension];
+    } else {
+      --value;
+      index_1d_ -= stride_[dimension];
+    }
+  }
+  return *this;
+}
+
+template<int size>
+constexpr typename StridedIndex<size>::Index_
+StridedIndex<size>::GetTotalNumberOfIndices() const {
+  Index_ total_number_of_indices{1};
+  for (Length const& length : length_) {
+    if (length != 0) {
+      total_number_of_indices *= length;
+    }
+  }
+  return total_number_of_indices;
+}
+
+#ifndef NDEBUG
+template<int size>
+void StridedIndex<size>::ThrowIfDimensionIsInvalid(
+    Dimension const& dimension) {
+  if (dimension < 0 || dimension >= size) {
+    throw OutOfRange("bsplinelib::utilities::StridedIndex - "
+                     + std::to_string(dimension) + " is out of bound ("
+                     + std::to_string(size) + ").");
+  }
+}
+#endif
@@ -19,6 +19,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "BSplineLib/Utilities/system_operations.hpp"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace bsplinelib::utilities::system_operations {
 
 LocalTime GetLocalTime() {
@@ -26,4 +30,14 @@ LocalTime GetLocalTime() {
   return *std::localtime(&calendar_time);
 }
 
+void AdviseHugePages(void* memory, std::size_t const& number_of_bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // failure only means that regular pages are used
+  madvise(memory, number_of_bytes, MADV_HUGEPAGE);
+#else
+  static_cast<void>(memory);
+  static_cast<void>(number_of_bytes);
+#endif
+}
+
 } // namespace bsplinelib::utilities::system_operations
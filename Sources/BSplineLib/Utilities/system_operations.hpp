@@ -20,6 +20,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #ifndef SOURCES_UTILITIES_SYSTEM_OPERATIONS_HPP_
 #define SOURCES_UTILITIES_SYSTEM_OPERATIONS_HPP_
 
+#include <cstddef>
 #include <ctime>
 #include <fstream>
 #include <ios>
@@ -27,11 +28,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "BSplineLib/Utilities/error_handling.hpp"
 
-// System operations such as 1.) getting the local time and 2.) opening files.
+// System operations such as 1.) getting the local time, 2.) opening files and
+// 3.) advising the use of huge pages.
 //
 // Example:
 //   LocalTime const &local_time = GetLocalTime();
 //   OutputStream output_stream{Open<OutputStream, kModeOut>("file.out")};
+//   AdviseHugePages(memory, number_of_bytes);  // No-op if not supported.
 namespace bsplinelib::utilities::system_operations {
 
 using File = std::string;
@@ -46,6 +49,11 @@ constexpr utilities::system_operations::Mode const kModeAppend{
 
 LocalTime GetLocalTime();
 
+// Advises the system to back the memory, which should be aligned to the huge
+// page size, by (transparent) huge pages.  Only a hint, i.e., the memory is
+// usable either way.  Currently only implemented for Linux.
+void AdviseHugePages(void* memory, std::size_t const& number_of_bytes);
+
 template<typename FileStream, Mode mode>
 FileStream Open(File const& file);
 
@@ -19,32 +19,45 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "BSplineLib/VectorSpaces/vector_space.hpp"
 
+#include <atomic>
+#include <cmath>
+
 namespace bsplinelib::vector_spaces {
 
-void VectorSpace::AppendEmptyCoordinates(const int n) {
-  const auto& shape = coordinates_.Shape();
-  const auto n_coord = shape[0];
-  const auto dim = shape[1];
+void VectorSpace::AppendEmptyCoordinates(const Index n) {
+  const auto n_coord = GetNumberOfCoordinates();
+  const auto dim = Dim();
+
+  if (layout_ == Layout::kStructureOfArrays) {
+    Coordinates_ new_coordinates(dim, n_coord + n);
+    for (int j{}; j < dim; ++j) {
+      std::copy_n(&std::as_const(*coordinates_)(j, 0),
+                  n_coord,
+                  &new_coordinates(j, 0));
+    }
+    SetCoordinates(std::move(new_coordinates));
+    return;
+  }
 
   Coordinates_ new_coordinates(n_coord + n, dim);
 
   // copy all the elements
-  std::copy_n(coordinates_.begin(),
-              coordinates_.size(),
+  std::copy_n(coordinates_->begin(),
+              coordinates_->size(),
               new_coordinates.begin());
 
   // move assign new coords as coords
-  coordinates_ = std::move(new_coordinates);
+  SetCoordinates(std::move(new_coordinates));
 }
 
-void VectorSpace::StaticInsert(int const& coordinate_index,
+void VectorSpace::StaticInsert(Index const& coordinate_index,
                                const Coordinate_& coordinate,
-                               int ignore_elements_from) {
+                               Index ignore_elements_from) {
+  MakeCoordinatesUnique();
 
   // size info
-  const auto& shape = coordinates_.Shape();
-  const auto n_coord = shape[0];
-  const auto dim = shape[1];
+  const auto n_coord = GetNumberOfCoordinates();
+  const auto dim = Dim();
 
   // runtime index checks
   // first, wrap id
@@ -68,14 +81,27 @@ void VectorSpace::StaticInsert(int const& coordinate_index,
 
   assert(dim == coordinate.size());
 
+  if (layout_ == Layout::kStructureOfArrays) {
+    for (int j{}; j < dim; ++j) {
+      DataType_* component = &(*coordinates_)(j, 0);
+      if (ignore_elements_from > coordinate_index) {
+        std::copy_backward(component + coordinate_index,
+                           component + ignore_elements_from,
+                           component + ignore_elements_from + 1);
+      }
+      component[coordinate_index] = coordinate[j];
+    }
+    return;
+  }
+
   // if inserting index is bigger than ignoring elements, we don't need to copy
   if (ignore_elements_from > coordinate_index) {
     // shift one coordinate
     // copy contents after index first, but backwards to avoid overlap
     // just make sure coordinate is not partial view of the coordinate_. if so,
     // copy!
-    auto* source_end = &coordinates_(ignore_elements_from, 0);
-    std::copy_backward(&coordinates_(coordinate_index, 0),
+    auto* source_end = &(*coordinates_)(ignore_elements_from, 0);
+    std::copy_backward(&(*coordinates_)(coordinate_index, 0),
                        source_end,
                        source_end + dim);
   }
@@ -83,29 +109,51 @@ void VectorSpace::StaticInsert(int const& coordinate_index,
   // copy at index
   std::copy_n(coordinate.begin(),
               coordinate.size(),
-              &coordinates_(coordinate_index, 0));
+              &(*coordinates_)(coordinate_index, 0));
 }
 
-void VectorSpace::Replace(int const& coordinate_index,
+void VectorSpace::Replace(Index const& coordinate_index,
                           const Coordinate_& coordinate) {
+  MakeCoordinatesUnique();
+  if (layout_ == Layout::kStructureOfArrays) {
+    for (int j{}; j < coordinate.size(); ++j) {
+      (*coordinates_)(j, coordinate_index) = coordinate[j];
+    }
+    return;
+  }
   std::copy_n(coordinate.begin(),
               coordinate.size(),
-              &coordinates_(coordinate_index, 0));
+              &(*coordinates_)(coordinate_index, 0));
 }
 
-void VectorSpace::ReallocateInsert(int const& coordinate_index,
+void VectorSpace::ReallocateInsert(Index const& coordinate_index,
                                    const Coordinate_& coordinate) {
   // This is a lot of copy
-  const auto& shape = coordinates_.Shape();
-  const auto& n_coord = shape[0];
-  const auto& dim = shape[1];
+  const auto n_coord = GetNumberOfCoordinates();
+  const auto dim = Dim();
 
   assert(dim == coordinate.size());
 
+  if (layout_ == Layout::kStructureOfArrays) {
+    Coordinates_ const& coordinates = *coordinates_;
+    Coordinates_ new_coordinates(dim, n_coord + 1);
+    for (int j{}; j < dim; ++j) {
+      const DataType_* component = &coordinates(j, 0);
+      DataType_* new_component = &new_coordinates(j, 0);
+      std::copy_n(component, coordinate_index, new_component);
+      new_component[coordinate_index] = coordinate[j];
+      std::copy(component + coordinate_index,
+                component + n_coord,
+                new_component + coordinate_index + 1);
+    }
+    SetCoordinates(std::move(new_coordinates));
+    return;
+  }
+
   Coordinates_ new_coordinates(n_coord + 1, dim);
 
   // copy (index) elements
-  std::copy_n(coordinates_.begin(),
+  std::copy_n(coordinates_->begin(),
               coordinate_index * dim,
               new_coordinates.begin());
 
@@ -113,34 +161,176 @@ void VectorSpace::ReallocateInsert(int const& coordinate_index,
   std::copy_n(coordinate.begin(), dim, &new_coordinates(coordinate_index, 0));
 
   // copy after index
-  std::copy(&coordinates_(coordinate_index, 0),
-            coordinates_.end(),
+  std::copy(&(*coordinates_)(coordinate_index, 0),
+            coordinates_->end(),
             &new_coordinates(coordinate_index + 1, 0));
 
   // move assign new coords as coords
-  coordinates_ = std::move(new_coordinates);
+  SetCoordinates(std::move(new_coordinates));
 }
 
-void VectorSpace::Erase(int const& coordinate_index) {
+void VectorSpace::Erase(Index const& coordinate_index) {
+  MakeCoordinatesUnique();
+  Coordinates_& coordinates = *coordinates_;
+
+  // ranges are shifted towards the front and may overlap (or coincide) with
+  // their destination, i.e., elements are assigned one by one from the front
+  auto const shift = [](const DataType_* first,
+                        const DataType_* last,
+                        DataType_* destination) {
+    for (; first != last; ++first, ++destination) {
+      *destination = *first;
+    }
+    return destination;
+  };
+
+  if (layout_ == Layout::kStructureOfArrays) {
+    // components are compacted, i.e., moved towards the front
+    const Index n_coord = coordinates.Shape()[1] - 1;
+    const int dim = coordinates.Shape()[0];
+    DataType_* destination = coordinates.begin();
+    for (int j{}; j < dim; ++j) {
+      const DataType_* component = &coordinates(j, 0);
+      destination = shift(component, component + coordinate_index, destination);
+      destination = shift(component + coordinate_index + 1,
+                          component + n_coord + 1,
+                          destination);
+    }
+    coordinates.SetShape(dim, n_coord);
+    return;
+  }
+
   // we just need to "shorten" data at erase space
-  std::copy(&coordinates_(coordinate_index + 1, 0),
-            coordinates_.end(),
-            &coordinates_(coordinate_index, 0));
+  shift(&coordinates(coordinate_index + 1, 0),
+        coordinates.end(),
+        &coordinates(coordinate_index, 0));
 
   // adjust shape only.
-  coordinates_.SetShape(coordinates_.Shape()[0] - 1, coordinates_.Shape()[1]);
+  coordinates.SetShape(coordinates.Shape()[0] - 1, coordinates.Shape()[1]);
+}
+
+void VectorSpace::SetLayout(Layout const& layout) {
+  if (layout == layout_) {
+    return;
+  }
+  coordinates_ = std::make_shared<Coordinates_>(Transpose(*coordinates_));
+  layout_ = layout;
+  revision_ = DetermineNextRevision();
+}
+
+typename VectorSpace::Coordinates_
+VectorSpace::CopyCoordinates(Layout const& layout) const {
+  if (layout != layout_) {
+    return Transpose(*coordinates_);
+  }
+  return *Clone(*coordinates_);
+}
+
+void VectorSpace::SetCoordinates(Coordinates_&& coordinates,
+                                 Layout const& layout) {
+  if (layout == layout_) {
+    SetCoordinates(std::move(coordinates));
+  } else {
+    SetCoordinates(Transpose(coordinates));
+  }
+}
+
+void VectorSpace::MakeCoordinatesUnique() {
+  if (coordinates_.use_count() > 1) {
+    coordinates_ = Clone(*coordinates_);
+  } else {
+    // sole owner: reads of copies released on other threads have to happen
+    // before the modification, use_count alone does not order them
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  // callers are about to (or may) modify the coordinates
+  revision_ = DetermineNextRevision();
+}
+
+SharedPointer<typename VectorSpace::Coordinates_>
+VectorSpace::Share(SharedPointer<Coordinates_> const& coordinates) {
+  if (coordinates->OwnsData() || coordinates->size() == 0) {
+    return coordinates;
+  }
+  return Clone(*coordinates);
+}
+
+SharedPointer<typename VectorSpace::Coordinates_>
+VectorSpace::Clone(Coordinates_ const& coordinates) {
+  if (coordinates.size() == 0) {
+    auto clone = std::make_shared<Coordinates_>();
+    clone->SetShape(coordinates.Shape()[0], coordinates.Shape()[1]);
+    return clone;
+  }
+  return std::make_shared<Coordinates_>(coordinates);
+}
+
+typename VectorSpace::Revision_ VectorSpace::DetermineNextRevision() {
+  static std::atomic<Revision_> next_revision{};
+  return next_revision.fetch_add(1, std::memory_order_relaxed);
+}
+
+typename VectorSpace::Coordinates_
+VectorSpace::Transpose(Coordinates_ const& coordinates) {
+  const Index rows = coordinates.Shape()[0], columns = coordinates.Shape()[1];
+  Coordinates_ transposed;
+  transposed.SetShape(columns, rows);
+  if (transposed.size() == 0) {
+    return transposed;
+  }
+  transposed.Reallocate(transposed.size());
+  for (Index i{}; i < rows; ++i) {
+    const DataType_* row = &coordinates(i, 0);
+    for (Index j{}; j < columns; ++j) {
+      transposed(j, i) = row[j];
+    }
+  }
+  return transposed;
+}
+
+typename VectorSpace::DataType_
+VectorSpace::DetermineMaximumDistanceFromOrigin(
+    int const& number_of_components) const {
+  // squared norms are accumulated component by component
+  Coordinates_ const& coordinates = *coordinates_;
+  const Index n_coords = coordinates.Shape()[1];
+  Vector_<DataType_> squared_norms(n_coords, DataType_{});
+  for (int j{}; j < number_of_components; ++j) {
+    const DataType_* component = &coordinates(j, 0);
+    for (Index i{}; i < n_coords; ++i) {
+      squared_norms[i] += component[i] * component[i];
+    }
+  }
+  DataType_ maximum_squared_distance{};
+  for (const DataType_& squared_norm : squared_norms) {
+    maximum_squared_distance = std::max(squared_norm, maximum_squared_distance);
+  }
+  return std::sqrt(maximum_squared_distance);
+}
+
+void VectorSpace::ThrowIfNotArrayOfStructures(
+    std::string const& function) const {
+  if (layout_ != Layout::kArrayOfStructures) {
+    throw RuntimeError("bsplinelib::vector_spaces::VectorSpace::" + function
+                       + " - coordinates are not stored as array of "
+                         "structures, i.e., a coordinate is not contiguous.");
+  }
 }
 
 typename VectorSpace::DataType_
 VectorSpace::DetermineMaximumDistanceFromOrigin() const {
+  if (layout_ == Layout::kStructureOfArrays) {
+    return DetermineMaximumDistanceFromOrigin(Dim());
+  }
+
   Coordinate maximum_distance{};
-  const auto& n_coords = coordinates_.Shape()[0];
-  const auto& dim = coordinates_.Shape()[1];
+  const auto& n_coords = coordinates_->Shape()[0];
+  const auto& dim = coordinates_->Shape()[1];
 
   ConstCoordinate_ view;
   view.SetShape(dim);
 
-  for (int i{}; i < n_coords; ++i) {
+  for (Index i{}; i < n_coords; ++i) {
     view.SetData(CoordinateBegin(i));
     maximum_distance = std::max(view.NormL2(), maximum_distance);
   }
@@ -151,15 +341,15 @@ VectorSpace::DetermineMaximumDistanceFromOrigin() const {
 typename VectorSpace::OutputInformation_
 VectorSpace::Write(Precision const& precision) const {
   // until we move iges to python, we create a type matching copy here.
-  const int n = coordinates_.Shape()[0];
-  const int d = coordinates_.Shape()[1];
+  const Index n = GetNumberOfCoordinates();
+  const int d = Dim();
 
-  const DataType_* coord_ptr = coordinates_.begin();
   Vector<Vector<DataType_>> nested_coordinates(n);
-  for (auto& nc : nested_coordinates) {
+  for (Index i{}; i < n; ++i) {
+    Vector<DataType_>& nc = nested_coordinates[i];
     nc.resize(d);
-    for (auto& c : nc) {
-      c = *coord_ptr++;
+    for (int j{}; j < d; ++j) {
+      nc[j] = (*this)(i, j);
     }
   }
 
@@ -21,8 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 #define SOURCES_VECTORSPACES_VECTOR_SPACE_HPP_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <string>
 #include <utility>
 
 #include "BSplineLib/Utilities/containers.hpp"
@@ -33,6 +35,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 namespace bsplinelib::vector_spaces {
 
+// Memory layouts of coordinates: kArrayOfStructures stores the components of a
+// coordinate contiguously, i.e., as (number of coordinates x dim) array, and
+// kStructureOfArrays stores each component of all coordinates contiguously,
+// i.e., as (dim x number of coordinates) array.
+enum class Layout { kArrayOfStructures, kStructureOfArrays };
+
 // VectorSpaces group coordinates.
 //
 // Example:
@@ -46,6 +54,26 @@ namespace bsplinelib::vector_spaces {
 //   vector_space[Index{1}];  // Coordinate P_1 = {1.0, 0.0, 0.0}.
 //   ScalarCoordinate const &one_point_zero =
 //   vector_space.DetermineMaximumDistanceFromOrigin();
+//
+// Copies share their coordinates until either of them is modified
+// (copy-on-write), i.e., copying is O(1).  Views of external data are copied
+// right away.  Mutators and non-const GetCoordinates clone shared coordinates
+// once per call.  The non-const element accessors (operator[], operator(),
+// CoordinateBegin) are plain accesses for loops over many coordinates, i.e.,
+// call MakeCoordinatesUnique once before writing through them.  References
+// obtained from non-const accessors must not be used for modifications after
+// copying.
+//
+// The layout of the coordinates is chosen at construction (array of structures
+// by default) and can be changed with SetLayout.  Coordinates are always passed
+// to the constructors as array of structures.  GetCoordinates and
+// SetCoordinates work on the storage, i.e., on the space's layout; use
+// operator()(i, j), CoordinateBegin together with the strides, or
+// CopyCoordinates for layout-independent access.
+//
+// Each state of the coordinates has a revision (GetRevision) that is unique
+// among all vector spaces, e.g., to tell whether data derived from the
+// coordinates is out of date.
 class VectorSpace {
 public:
   using DataType_ = Coordinate;
@@ -54,82 +82,202 @@ public:
   using Data_ = bsplinelib::utilities::containers::Data<T, 1>;
   template<typename T>
   using Data2D_ = bsplinelib::utilities::containers::Data<T, 2>;
+  // aligned and, if large, backed by huge pages
+  template<typename T>
+  using CoordinatesData_ = bsplinelib::utilities::containers::Data<
+      T,
+      2,
+      Index,
+      bsplinelib::utilities::containers::AlignedAllocator<
+          T,
+          bsplinelib::utilities::containers::kDataAlignment,
+          true>>;
   template<typename T>
   using Vector_ =
       bsplinelib::utilities::containers::DefaultInitializationVector<T>;
 
   using Coordinate_ = Data_<DataType_>;
   using ConstCoordinate_ = Data_<const DataType_>;
-  using Coordinates_ = Data2D_<DataType_>;
+  using Coordinates_ = CoordinatesData_<DataType_>;
   using OutputInformation_ = Tuple<Vector<StringVector>>;
+  using Revision_ = std::uint64_t;
 
   VectorSpace() = default;
 
   /// @brief coordinate copy ctor
-  /// @param coordinates
-  explicit VectorSpace(const Coordinates_& coordinates) {
-    // copy
-    coordinates_ = coordinates;
-  }
+  /// @param coordinates (number of coordinates x dim) array
+  /// @param layout
+  explicit VectorSpace(const Coordinates_& coordinates,
+                       Layout const& layout = Layout::kArrayOfStructures)
+      : coordinates_(layout == Layout::kArrayOfStructures
+                         ? std::make_shared<Coordinates_>(coordinates)
+                         : std::make_shared<Coordinates_>(
+                             Transpose(coordinates))),
+        layout_(layout) {}
 
   /// @brief coordinate move ctor
-  /// @param coordinates
-  explicit VectorSpace(Coordinates_&& coordinates) {
-    coordinates_ = std::move(coordinates);
-  }
-
-  /// @brief data pointer ctor
+  /// @param coordinates (number of coordinates x dim) array
+  /// @param layout
+  explicit VectorSpace(Coordinates_&& coordinates,
+                       Layout const& layout = Layout::kArrayOfStructures)
+      : coordinates_(layout == Layout::kArrayOfStructures
+                         ? std::make_shared<Coordinates_>(
+                             std::move(coordinates))
+                         : std::make_shared<Coordinates_>(
+                             Transpose(coordinates))),
+        layout_(layout) {}
+
+  /// @brief data pointer ctor.  Views the caller's coordinates, stored as
+  /// array of structures, without copying them.  The caller keeps ownership,
+  /// i.e., the data has to outlive this vector space and the splines using it.
+  /// Modifications write through to the data, copies own a copy of it.
   /// @param data
-  /// @param shape0
-  /// @param shape1
-  explicit VectorSpace(Coordinate* data, const int& shape0, const int& shape1) {
+  /// @param shape0 number of coordinates
+  /// @param shape1 dim
+  explicit VectorSpace(Coordinate* data,
+                       const Index& shape0,
+                       const Index& shape1) {
     // take data and make a 2d view
-    coordinates_.SetData(data);
-    coordinates_.SetShape(shape0, shape1);
+    coordinates_->SetData(data);
+    coordinates_->SetShape(shape0, shape1);
   }
 
-  VectorSpace(VectorSpace const& other) = default;
+  VectorSpace(VectorSpace const& other)
+      : coordinates_(Share(other.coordinates_)),
+        layout_(other.layout_),
+        revision_(other.revision_) {}
   VectorSpace(VectorSpace&& other) noexcept = default;
-  VectorSpace& operator=(VectorSpace const& rhs) = default;
+  VectorSpace& operator=(VectorSpace const& rhs) {
+    coordinates_ = Share(rhs.coordinates_);
+    layout_ = rhs.layout_;
+    revision_ = rhs.revision_;
+    return *this;
+  }
   VectorSpace& operator=(VectorSpace&& rhs) noexcept = default;
   virtual ~VectorSpace() = default;
 
-  /// @brief dim - shape[1] of coordinates_
+  /// @brief dim - number of components of a coordinate
+  /// @return
+  virtual int Dim() const {
+    return coordinates_->Shape()[layout_ == Layout::kArrayOfStructures ? 1 : 0];
+  }
+
+  /// @brief Contiguous view of a coordinate. Only available for array of
+  /// structures.
+  /// @param i
+  /// @return
+  virtual Coordinate_ operator[](const Index& i) {
+    ThrowIfNotArrayOfStructures("operator[]");
+    return Coordinate_(&(*coordinates_)(i, 0), coordinates_->Shape()[1]);
+  }
+  virtual ConstCoordinate_ operator[](const Index& i) const {
+    ThrowIfNotArrayOfStructures("operator[]");
+    Coordinates_ const& coordinates = *coordinates_;
+    return ConstCoordinate_(&coordinates(i, 0), coordinates.Shape()[1]);
+  }
+
+  /// @brief j-th component of the i-th coordinate
+  /// @param i
+  /// @param j
   /// @return
-  virtual int Dim() const { return coordinates_.Shape()[1]; }
+  DataType_& operator()(const Index& i, const int& j) {
+    return coordinates_->data()[i * GetCoordinateStride()
+                                + j * GetComponentStride()];
+  }
+  DataType_ const& operator()(const Index& i, const int& j) const {
+    return std::as_const(*coordinates_)
+        .data()[i * GetCoordinateStride() + j * GetComponentStride()];
+  }
 
-  virtual Coordinate_ operator[](const int& i) {
-    return Coordinate_(&coordinates_(i, 0), coordinates_.Shape()[1]);
+  /// @brief First component of the i-th coordinate. Its components are
+  /// GetComponentStride() apart.
+  /// @param i
+  /// @return
+  virtual DataType_* CoordinateBegin(const Index& i) {
+    return coordinates_->begin() + i * GetCoordinateStride();
   }
-  virtual ConstCoordinate_ operator[](const int& i) const {
-    return ConstCoordinate_(&coordinates_(i, 0), coordinates_.Shape()[1]);
+
+  virtual const DataType_* CoordinateBegin(const Index& i) const {
+    return std::as_const(*coordinates_).begin() + i * GetCoordinateStride();
   }
 
-  virtual DataType_* CoordinateBegin(const int& i) {
-    return &coordinates_(i, 0);
+  /// @brief distance between consecutive coordinates in the storage
+  /// @return
+  Index GetCoordinateStride() const {
+    return layout_ == Layout::kArrayOfStructures ? coordinates_->Shape()[1]
+                                                 : 1;
   }
 
-  virtual const DataType_* CoordinateBegin(const int& i) const {
-    return &coordinates_(i, 0);
+  /// @brief distance between consecutive components in the storage
+  /// @return
+  Index GetComponentStride() const {
+    return layout_ == Layout::kArrayOfStructures ? 1
+                                                 : coordinates_->Shape()[1];
+  }
+
+  /// @brief layout getter
+  /// @return
+  Layout const& GetLayout() const { return layout_; }
+
+  /// @brief Converts the coordinates to the given layout.
+  /// @param layout
+  virtual void SetLayout(Layout const& layout);
+
+  /// @brief coordinates getter - if you change size, call. Storage, i.e., in
+  /// the space's layout.
+  /// @return
+  virtual Coordinates_& GetCoordinates() {
+    MakeCoordinatesUnique();
+    return *coordinates_;
   }
 
-  /// @brief coordinates getter - if you change size, call
+  /// @brief const coordinates getter. Storage, i.e., in the space's layout.
   /// @return
-  virtual Coordinates_& GetCoordinates() { return coordinates_; }
+  virtual Coordinates_ const& GetCoordinates() const { return *coordinates_; }
 
-  /// @brief const coordinates getter
+  /// @brief Copy of the coordinates in the given layout.
+  /// @param layout
   /// @return
-  virtual Coordinates_ const& GetCoordinates() const { return coordinates_; }
+  virtual Coordinates_ CopyCoordinates(Layout const& layout) const;
+
+  /// @brief Replaces all coordinates. Unlike assigning to GetCoordinates(),
+  /// coordinates shared with copies are not cloned beforehand.
+  /// @param coordinates in the space's layout
+  virtual void SetCoordinates(Coordinates_&& coordinates) {
+    coordinates_ = std::make_shared<Coordinates_>(std::move(coordinates));
+    revision_ = DetermineNextRevision();
+  }
 
-  /// @brief shape[0] of coordinates array
+  /// @brief Replaces all coordinates given in any layout.
+  /// @param coordinates
+  /// @param layout of coordinates
+  virtual void SetCoordinates(Coordinates_&& coordinates,
+                              Layout const& layout);
+
+  /// @brief Revision of the coordinates. It changes whenever they are replaced,
+  /// modified by a mutator, or made unique, i.e., references obtained from
+  /// non-const accessors must not be used for modifications after reading the
+  /// revision.  Copies start with the revision of the original.  Modifications
+  /// of external data viewed by the space are not tracked.
   /// @return
-  virtual int GetNumberOfCoordinates() const { return coordinates_.Shape()[0]; }
+  Revision_ const& GetRevision() const { return revision_; }
+
+  /// @brief Clones the coordinates if they are shared with copies and changes
+  /// the revision.  Call once before writing through the non-const element
+  /// accessors.
+  void MakeCoordinatesUnique();
+
+  /// @brief number of coordinates
+  /// @return
+  virtual Index GetNumberOfCoordinates() const {
+    return coordinates_->Shape()[layout_ == Layout::kArrayOfStructures ? 0 : 1];
+  }
 
   /// @brief Appends empty (not initialized) coordinates. Similar use case as
   /// vector::reserve(), instead, it will change the size right away. You can
   /// use in combination with Insert() to replace ReallocateInsert()
   /// @param n
-  virtual void AppendEmptyCoordinates(const int n);
+  virtual void AppendEmptyCoordinates(const Index n);
 
   /// @brief Similar use case as vector::reserve() then vector::insert(),
   /// instead we work only with size (without the concept of capacity).
@@ -145,27 +293,27 @@ public:
   /// @param coordinate
   /// @param ignore_elements_from takes python style negative indexing. However,
   /// up to one cycle.
-  virtual void StaticInsert(int const& coordinate_index,
+  virtual void StaticInsert(Index const& coordinate_index,
                             const Coordinate_& coordinate,
-                            int ignore_elements_from = -1);
+                            Index ignore_elements_from = -1);
 
   /// @brief Replace coordinate value
   /// @param coordinate_index
   /// @param coordinate
-  virtual void Replace(int const& coordinate_index,
+  virtual void Replace(Index const& coordinate_index,
                        const Coordinate_& coordinate);
 
   /// @brief Inserts a coordinate. This will invalidate any iterator / pointer
   /// to existing coordinates
   /// @param coordinate_index
   /// @param coordinate
-  virtual void ReallocateInsert(int const& coordinate_index,
+  virtual void ReallocateInsert(Index const& coordinate_index,
                                 const Coordinate_& coordinate);
 
   /// @brief Erases a coordinate. This will invalidate any iterator / pointer to
   /// existing coords. Doesn't reallocate.
   /// @param coordinate_index
-  virtual void Erase(int const& coordinate_index);
+  virtual void Erase(Index const& coordinate_index);
 
   /// @brief Computes max norm of the coordinate.
   /// @param tolerance
@@ -179,8 +327,29 @@ public:
   Write(Precision const& precision = kPrecision) const;
 
 protected:
-  /// 2D, contiguous array. For Insert and Erase, you need to own the data
-  Coordinates_ coordinates_;
+  /// 2D, contiguous array. For Insert and Erase, you need to own the data.
+  /// Shared with copies until modified.
+  SharedPointer<Coordinates_> coordinates_{std::make_shared<Coordinates_>()};
+  Layout layout_{Layout::kArrayOfStructures};
+  Revision_ revision_{DetermineNextRevision()};
+
+  // Converts between array of structures and structure of arrays.
+  static Coordinates_ Transpose(Coordinates_ const& coordinates);
+
+  // Maximum norm of the first number_of_components components of coordinates
+  // stored as structure of arrays.
+  DataType_
+  DetermineMaximumDistanceFromOrigin(int const& number_of_components) const;
+
+  void ThrowIfNotArrayOfStructures(std::string const& function) const;
+
+private:
+  // Coordinates for a copy, i.e., shared unless they view external data.
+  static SharedPointer<Coordinates_>
+  Share(SharedPointer<Coordinates_> const& coordinates);
+  static SharedPointer<Coordinates_> Clone(Coordinates_ const& coordinates);
+  // Unique among all vector spaces and thread-safe.
+  static Revision_ DetermineNextRevision();
 };
 
 } // namespace bsplinelib::vector_spaces
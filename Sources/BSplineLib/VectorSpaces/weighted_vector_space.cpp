@@ -22,8 +22,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 namespace bsplinelib::vector_spaces {
 
 WeightedVectorSpace::WeightedVectorSpace(Coordinates_ const& coordinates,
-                                         Weights_ const& weights) {
+                                         Weights_ const& weights,
+                                         Layout const& layout) {
   HomogenizeCoordinates(coordinates, weights);
+  Base_::SetLayout(layout);
 }
 
 typename WeightedVectorSpace::Coordinate_ WeightedVectorSpace::Project(
@@ -40,19 +42,43 @@ typename WeightedVectorSpace::Coordinate_ WeightedVectorSpace::Project(
   return projected;
 }
 
+void WeightedVectorSpace::Homogenize(DataType_* coordinates_and_weights,
+                                     Index const& number_of_coordinates,
+                                     int const& dim) {
+  DataType_* h_coord = coordinates_and_weights;
+  for (Index i{}; i < number_of_coordinates; ++i) {
+    const DataType_ w = h_coord[dim];
+    for (int j{}; j < dim; ++j) {
+      h_coord[j] *= w;
+    }
+    h_coord += dim + 1;
+  }
+}
+
 typename WeightedVectorSpace::MaximumDistanceFromOriginAndMinimumWeight_
 WeightedVectorSpace::DetermineMaximumDistanceFromOriginAndMinimumWeight()
     const {
   Coordinate maximum_distance{};
   Weight minimum_weight{std::numeric_limits<Weight>::max()};
 
-  const auto& n_coords = coordinates_.Shape()[0];
-  const auto& h_dim = coordinates_.Shape()[1];
+  if (layout_ == Layout::kStructureOfArrays) {
+    Coordinates_ const& coordinates = *coordinates_;
+    const int dim = coordinates.Shape()[0] - 1;
+    const Index n_coords = coordinates.Shape()[1];
+    const Weight* weights = &coordinates(dim, 0);
+    for (Index i{}; i < n_coords; ++i) {
+      minimum_weight = std::min(weights[i], minimum_weight);
+    }
+    return {Base_::DetermineMaximumDistanceFromOrigin(dim), minimum_weight};
+  }
+
+  const auto& n_coords = coordinates_->Shape()[0];
+  const auto& h_dim = coordinates_->Shape()[1];
 
   // get a view, excluding weight
   ConstCoordinate_ view;
   view.SetShape(h_dim - 1);
-  for (int i{}; i < n_coords; ++i) {
+  for (Index i{}; i < n_coords; ++i) {
     view.SetData(Base_::CoordinateBegin(i));
     maximum_distance = std::max(view.NormL2(), maximum_distance);
     // typically end() means one after the last valid element, but in this case
@@ -64,14 +90,13 @@ WeightedVectorSpace::DetermineMaximumDistanceFromOriginAndMinimumWeight()
   return {maximum_distance, minimum_weight};
 }
 
-constexpr void
-WeightedVectorSpace::HomogenizeCoordinates(Coordinates_ const& coordinates,
-                                           Weights_ const& weights) {
+void WeightedVectorSpace::HomogenizeCoordinates(Coordinates_ const& coordinates,
+                                                Weights_ const& weights) {
   using std::to_string;
 
-  const int number_of_coordinates = coordinates.Shape()[0];
+  const Index number_of_coordinates = coordinates.Shape()[0];
   const int dim = coordinates.Shape()[1];
-  const int number_of_weights = weights.size();
+  const Index number_of_weights = weights.size();
 
   // size check
   if (number_of_coordinates != number_of_weights)
@@ -82,13 +107,14 @@ WeightedVectorSpace::HomogenizeCoordinates(Coordinates_ const& coordinates,
 
   // those are homogenized coordinates
   // first set shape -> this computes size
-  Base_::coordinates_.SetShape(number_of_coordinates, dim + 1);
-  Base_::coordinates_.Reallocate(Base_::coordinates_.size());
+  Coordinates_ homogeneous_coordinates;
+  homogeneous_coordinates.SetShape(number_of_coordinates, dim + 1);
+  homogeneous_coordinates.Reallocate(homogeneous_coordinates.size());
 
-  auto* h_coord = Base_::coordinates_.begin();
+  auto* h_coord = homogeneous_coordinates.begin();
   const auto* coord = coordinates.begin();
   const auto* weight = weights.begin();
-  for (int i{}; i < number_of_coordinates; ++i) {
+  for (Index i{}; i < number_of_coordinates; ++i) {
     // apply weight
     const auto& w = *weight; // we deref here just to avoid (* *weight)
     for (int j{}; j < dim; ++j) {
@@ -97,6 +123,7 @@ WeightedVectorSpace::HomogenizeCoordinates(Coordinates_ const& coordinates,
     // assign weight
     *h_coord++ = *weight++;
   }
+  Base_::SetCoordinates(std::move(homogeneous_coordinates));
 }
 
 typename WeightedVectorSpace::OutputInformation_
@@ -105,20 +132,20 @@ WeightedVectorSpace::WriteProjected(Precision const& precision) const {
   using ProjectedCoordinatesOutput = tuple_element_t<0, OutputInformation_>;
   using utilities::string_operations::Write;
 
-  HomogeneousCoordinates_ const& homogeneous_coordinates = Base_::coordinates_;
-  const int n = homogeneous_coordinates.Shape()[0];
-  const int d = homogeneous_coordinates.Shape()[1] - 1;
+  const Index n = GetNumberOfCoordinates();
+  const int d = Dim() - 1;
+  const Index component_stride = GetComponentStride();
 
   ProjectedCoordinatesOutput coordinates(n);
 
   tuple_element_t<1, OutputInformation_> weights(n);
-  for (int i{}; i < n; ++i) {
+  for (Index i{}; i < n; ++i) {
     // get beggining of the homogeneous coordinate
-    const double* h_coord = &homogeneous_coordinates(i, 0);
+    const DataType_* h_coord = Base_::CoordinateBegin(i);
 
     // get weight
-    const double& w = h_coord[d];
-    const double w_inv = 1. / w;
+    const DataType_& w = h_coord[d * component_stride];
+    const DataType_ w_inv = static_cast<DataType_>(1.0) / w;
 
     // save weight
     weights[i] = Write(w, precision);
@@ -130,7 +157,8 @@ WeightedVectorSpace::WriteProjected(Precision const& precision) const {
 
     // project coord and save
     for (auto& ps : projected_str) {
-      ps = Write(*h_coord++ * w_inv, precision);
+      ps = Write(*h_coord * w_inv, precision);
+      h_coord += component_stride;
     }
   }
 
@@ -37,6 +37,13 @@ namespace bsplinelib::vector_spaces {
 // WeightedVectorSpaces store coordinates and weights together using
 // homogeneous, i.e., weighted coordinates.
 //
+// Example (viewing the caller's coordinates and weights without copying them,
+// see VectorSpace's data pointer ctor for the ownership):
+//   // (number of coordinates x 4) array of (x, y, z, w)
+//   WeightedVectorSpace::Homogenize(data, number_of_coordinates, 3);
+//   WeightedVectorSpace const weighted_vector_space{data,
+//                                                   number_of_coordinates,
+//                                                   Index{4}};
 class WeightedVectorSpace : public VectorSpace {
 public:
   using Base_ = VectorSpace;
@@ -54,7 +61,9 @@ public:
   using Base_::Base_;
 
   WeightedVectorSpace() = default;
-  WeightedVectorSpace(Coordinates_ const& coordinates, Weights_ const& weights);
+  WeightedVectorSpace(Coordinates_ const& coordinates,
+                      Weights_ const& weights,
+                      Layout const& layout = Layout::kArrayOfStructures);
   WeightedVectorSpace(WeightedVectorSpace const& other) = default;
   WeightedVectorSpace(WeightedVectorSpace&& other) noexcept = default;
   WeightedVectorSpace& operator=(WeightedVectorSpace const& rhs) = default;
@@ -63,6 +72,14 @@ public:
 
   static Coordinate_
   Project(HomogeneousCoordinate_ const& homogeneous_coordinate);
+  /// @brief Homogenizes the caller's coordinates in place, i.e., multiplies
+  /// the first dim components of each row by its last component, the weight.
+  /// @param coordinates_and_weights (number_of_coordinates x dim + 1) array
+  /// @param number_of_coordinates
+  /// @param dim
+  static void Homogenize(DataType_* coordinates_and_weights,
+                         Index const& number_of_coordinates,
+                         int const& dim);
 
   virtual MaximumDistanceFromOriginAndMinimumWeight_
   DetermineMaximumDistanceFromOriginAndMinimumWeight() const;
@@ -71,8 +88,8 @@ public:
   WriteProjected(Precision const& precision = kPrecision) const;
 
 private:
-  constexpr void HomogenizeCoordinates(Coordinates_ const& coordinates,
-                                       Weights_ const& weights);
+  void HomogenizeCoordinates(Coordinates_ const& coordinates,
+                             Weights_ const& weights);
 };
 
 } // namespace bsplinelib::vector_spaces
@@ -0,0 +1,559 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Splines/nurbs.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+#include "BSplineLib/VectorSpaces/weighted_vector_space.hpp"
+
+namespace bsplinelib::splines {
+namespace {
+
+using parameter_spaces::KnotVector;
+using vector_spaces::VectorSpace;
+using vector_spaces::WeightedVectorSpace;
+template<int para_dim>
+using ParameterSpace = parameter_spaces::ParameterSpace<para_dim>;
+using Samples = Vector<Type>;
+
+constexpr Type const kTolerance{Type{1000}
+                                * std::numeric_limits<Type>::epsilon()};
+
+// Open parameter space on [0, 1]^para_dim with given interior knots.
+template<int para_dim>
+SharedPointer<ParameterSpace<para_dim>>
+MakeParameterSpace(Array<Degree, para_dim> const& degrees,
+                   Array<Vector<Type>, para_dim> const& interior_knots) {
+  typename ParameterSpace<para_dim>::KnotVectors_ knot_vectors;
+  for (int i{}; i < para_dim; ++i) {
+    Vector<Type> knots(degrees[i] + 1, Type{0});
+    knots.insert(knots.end(), interior_knots[i].begin(),
+                 interior_knots[i].end());
+    knots.insert(knots.end(), degrees[i] + 1, Type{1});
+    knot_vectors[i] = std::make_shared<KnotVector>(knots);
+  }
+  return std::make_shared<ParameterSpace<para_dim>>(knot_vectors, degrees);
+}
+
+template<int para_dim>
+VectorSpace::Coordinates_
+MakeCoordinates(ParameterSpace<para_dim> const& parameter_space,
+                int const& dim) {
+  std::mt19937 random_number_generator{42};
+  std::uniform_real_distribution<Type> distribution{};
+  VectorSpace::Coordinates_ coordinates(
+      parameter_space.GetTotalNumberOfBasisFunctions(), dim);
+  for (Type& coordinate : coordinates) {
+    coordinate = distribution(random_number_generator);
+  }
+  return coordinates;
+}
+
+// B-spline on [0, 1]^para_dim with random coordinates.
+template<int para_dim>
+SharedPointer<BSpline<para_dim>>
+MakeBSpline(Array<Degree, para_dim> const& degrees,
+            Array<Vector<Type>, para_dim> const& interior_knots,
+            int const& dim) {
+  SharedPointer<ParameterSpace<para_dim>> parameter_space{
+      MakeParameterSpace<para_dim>(degrees, interior_knots)};
+  VectorSpace::Coordinates_ coordinates{MakeCoordinates(*parameter_space, dim)};
+  return std::make_shared<BSpline<para_dim>>(
+      std::move(parameter_space),
+      std::make_shared<VectorSpace>(std::move(coordinates)));
+}
+
+// NURBS on [0, 1]^para_dim with random coordinates and weights in [0.5, 1.5).
+template<int para_dim>
+SharedPointer<Nurbs<para_dim>>
+MakeNurbs(Array<Degree, para_dim> const& degrees,
+          Array<Vector<Type>, para_dim> const& interior_knots,
+          int const& dim) {
+  SharedPointer<ParameterSpace<para_dim>> parameter_space{
+      MakeParameterSpace<para_dim>(degrees, interior_knots)};
+  VectorSpace::Coordinates_ const coordinates{
+      MakeCoordinates(*parameter_space, dim)};
+  WeightedVectorSpace::Weights_ weights(
+      parameter_space->GetTotalNumberOfBasisFunctions());
+  for (Index i{}; i < static_cast<Index>(weights.size()); ++i) {
+    weights[i] = Type{0.5} + coordinates(i, 0);
+  }
+  return std::make_shared<Nurbs<para_dim>>(
+      std::move(parameter_space),
+      std::make_shared<WeightedVectorSpace>(coordinates, weights));
+}
+
+// Random parametric coordinates in [0, 1]^para_dim.
+template<int para_dim>
+Samples MakeParametricCoordinates(int const& number_of_parametric_coordinates) {
+  std::mt19937 random_number_generator{7};
+  std::uniform_real_distribution<Type> distribution{};
+  Samples parametric_coordinates(number_of_parametric_coordinates * para_dim);
+  for (Type& parametric_coordinate : parametric_coordinates) {
+    parametric_coordinate = distribution(random_number_generator);
+  }
+  return parametric_coordinates;
+}
+
+// Evaluates the spline at each parametric coordinate.
+template<int para_dim, typename Spline>
+Samples Sample(Spline const& spline, Samples const& parametric_coordinates) {
+  int const dim{spline.Dim()};
+  int const number_of_parametric_coordinates{
+      static_cast<int>(parametric_coordinates.size()) / para_dim};
+  Samples evaluated(number_of_parametric_coordinates * dim);
+  for (int i{}; i < number_of_parametric_coordinates; ++i) {
+    spline.Evaluate(&parametric_coordinates[i * para_dim],
+                    &evaluated[i * dim]);
+  }
+  return evaluated;
+}
+
+template<int para_dim, typename Spline>
+Samples Sample(Spline const& spline) {
+  return Sample<para_dim>(spline, MakeParametricCoordinates<para_dim>(100));
+}
+
+template<typename Lhs, typename Rhs>
+Type MaximumDifference(Lhs const& lhs, Rhs const& rhs) {
+  Type maximum_difference{};
+  auto rhs_value = std::begin(rhs);
+  for (Type const& lhs_value : lhs) {
+    maximum_difference =
+        std::max(maximum_difference,
+                 static_cast<Type>(std::abs(lhs_value - *rhs_value)));
+    ++rhs_value;
+  }
+  return maximum_difference;
+}
+
+Type EvaluateBernsteinPolynomial(int const& degree,
+                                 int const& index,
+                                 Type const& parametric_coordinate) {
+  Type binomial_coefficient{1};
+  for (int i{1}; i <= index; ++i) {
+    binomial_coefficient = binomial_coefficient * (degree - i + 1) / i;
+  }
+  return binomial_coefficient * std::pow(parametric_coordinate, index)
+         * std::pow(Type{1} - parametric_coordinate, degree - index);
+}
+
+// Evaluates each Bezier patch in Bernstein form within its bounds and compares
+// it with the spline.
+template<int para_dim>
+void ExpectBezierPatchesMatch(BSpline<para_dim> const& b_spline,
+                              Array<Degree, para_dim> const& degrees,
+                              Index const& number_of_elements) {
+  auto const& [patches, bounds] = b_spline.ExtractBezierPatches();
+  ASSERT_EQ(bounds.Shape()[0], number_of_elements);
+  int number_of_control_points{1};
+  for (Degree const& degree : degrees) {
+    number_of_control_points *= degree + 1;
+  }
+  int const dim{b_spline.Dim()};
+  Samples const ratios{MakeParametricCoordinates<para_dim>(5)};
+  for (Index element{}; element < number_of_elements; ++element) {
+    for (int k{}; k < 5; ++k) {
+      Array<Type, para_dim> parametric_coordinate;
+      for (int i{}; i < para_dim; ++i) {
+        parametric_coordinate[i] =
+            bounds(element, i)
+            + ratios[k * para_dim + i]
+                  * (bounds(element, para_dim + i) - bounds(element, i));
+      }
+      Samples expected(dim), evaluated(dim, Type{0});
+      b_spline.Evaluate(parametric_coordinate.data(), expected.data());
+      for (int l{}; l < number_of_control_points; ++l) {
+        Type basis_value{1};
+        for (int i{}, remainder{l}; i < para_dim; ++i) {
+          basis_value *=
+              EvaluateBernsteinPolynomial(degrees[i],
+                                          remainder % (degrees[i] + 1),
+                                          ratios[k * para_dim + i]);
+          remainder /= degrees[i] + 1;
+        }
+        for (int j{}; j < dim; ++j) {
+          evaluated[j] +=
+              basis_value * patches(element * number_of_control_points + l, j);
+        }
+      }
+      EXPECT_LT(MaximumDifference(expected, evaluated), kTolerance);
+    }
+  }
+}
+
+TEST(BSplineTest, BezierPatchesMatchSpline) {
+  ExpectBezierPatchesMatch<1>(
+      *MakeBSpline<1>({3}, {{{0.2, 0.5, 0.5, 0.7}}}, 2), {3}, 4);
+  ExpectBezierPatchesMatch<2>(
+      *MakeBSpline<2>({2, 3}, {{{0.3, 0.6}, {0.5, 0.5, 0.8}}}, 3), {2, 3}, 9);
+  ExpectBezierPatchesMatch<3>(
+      *MakeBSpline<3>({1, 2, 2}, {{{0.5}, {0.25}, {}}}, 3), {1, 2, 2}, 4);
+}
+
+TEST(BSplineTest, BezierPatchesDoNotDependOnNumberOfThreads) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({2, 3}, {{{0.3, 0.6}, {0.5, 0.5, 0.8}}}, 3)};
+  auto const& [serial, serial_bounds] = b_spline->ExtractBezierPatches(1);
+  auto const& [parallel, parallel_bounds] = b_spline->ExtractBezierPatches(3);
+  EXPECT_EQ(MaximumDifference(serial, parallel), Type{0});
+  EXPECT_EQ(MaximumDifference(serial_bounds, parallel_bounds), Type{0});
+}
+
+// Knot insertion and degree elevation do not change the geometry.
+TEST(BSplineTest, RefinementKeepsGeometry) {
+  SharedPointer<BSpline<1>> const curve{
+      MakeBSpline<1>({3}, {{{0.2, 0.5}}}, 2)};
+  Samples const curve_samples{Sample<1>(*curve)};
+  curve->InsertKnot(Dimension{0}, 0.3);
+  curve->InsertKnot(Dimension{0}, 0.5, Multiplicity{2});
+  curve->ElevateDegree(Dimension{0}, Multiplicity{2});
+  EXPECT_LT(MaximumDifference(curve_samples, Sample<1>(*curve)), kTolerance);
+
+  SharedPointer<BSpline<2>> const surface{
+      MakeBSpline<2>({2, 3}, {{{0.3, 0.6}, {0.5, 0.5}}}, 3)};
+  Samples const surface_samples{Sample<2>(*surface)};
+  surface->ElevateDegree(Dimension{0});
+  surface->InsertKnot(Dimension{1}, 0.2, Multiplicity{2});
+  surface->RefineKnots(Dimension{0}, {0.1, 0.45, 0.7});
+  EXPECT_LT(MaximumDifference(surface_samples, Sample<2>(*surface)),
+            kTolerance);
+
+  SharedPointer<Nurbs<2>> const nurbs{
+      MakeNurbs<2>({2, 2}, {{{0.4}, {0.3, 0.3}}}, 3)};
+  Samples const nurbs_samples{Sample<2>(*nurbs)};
+  nurbs->InsertKnot(Dimension{0}, 0.6);
+  nurbs->ElevateDegree(Dimension{1});
+  EXPECT_LT(MaximumDifference(nurbs_samples, Sample<2>(*nurbs)), kTolerance);
+}
+
+// Removing an inserted knot and reducing an elevated degree is exact.
+TEST(BSplineTest, RemoveKnotAndReduceDegreeUndoRefinement) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({2, 2}, {{{0.5}, {}}}, 2)};
+  Samples const samples{Sample<2>(*b_spline)};
+  b_spline->InsertKnot(Dimension{0}, 0.25);
+  b_spline->ElevateDegree(Dimension{1});
+  EXPECT_EQ(b_spline->RemoveKnot(Dimension{0}, 0.25, kTolerance),
+            Multiplicity{1});
+  EXPECT_TRUE(b_spline->ReduceDegree(Dimension{1}, kTolerance));
+  EXPECT_LT(MaximumDifference(samples, Sample<2>(*b_spline)), kTolerance);
+}
+
+// Lines of coordinates are rebuilt independently, i.e., the result does not
+// depend on the number of threads.
+TEST(BSplineTest, RefinementDoesNotDependOnNumberOfThreads) {
+  Array<SharedPointer<VectorSpace>, 2> vector_spaces;
+  for (int i{}; i < 2; ++i) {
+    SharedPointer<ParameterSpace<2>> const parameter_space{
+        MakeParameterSpace<2>({2, 3}, {{{0.3, 0.6}, {0.5}}})};
+    vector_spaces[i] =
+        std::make_shared<VectorSpace>(MakeCoordinates(*parameter_space, 3));
+    BSpline<2> const b_spline{parameter_space, vector_spaces[i]};
+    int const number_of_threads{i == 0 ? 1 : 4};
+    b_spline.InsertKnot(Dimension{0}, 0.45, Multiplicity{2}, kEpsilon,
+                        number_of_threads);
+    b_spline.ElevateDegree(Dimension{1}, Multiplicity{1}, kEpsilon,
+                           number_of_threads);
+  }
+  VectorSpace::Coordinates_ const& serial =
+      std::as_const(*vector_spaces[0]).GetCoordinates();
+  VectorSpace::Coordinates_ const& parallel =
+      std::as_const(*vector_spaces[1]).GetCoordinates();
+  EXPECT_EQ(MaximumDifference(serial, parallel), Type{0});
+}
+
+// A refinement plan yields the same spline as the equivalent sequence of
+// degree elevations and knot insertions.
+TEST(BSplineTest, RefinePlanMatchesSingleRefinements) {
+  Array<SharedPointer<VectorSpace>, 2> vector_spaces;
+  Array<SharedPointer<ParameterSpace<3>>, 2> parameter_spaces;
+  for (int i{}; i < 2; ++i) {
+    parameter_spaces[i] =
+        MakeParameterSpace<3>({1, 2, 2}, {{{0.5}, {0.25}, {}}});
+    vector_spaces[i] = std::make_shared<VectorSpace>(
+        MakeCoordinates(*parameter_spaces[i], 2));
+    BSpline<3> const b_spline{parameter_spaces[i], vector_spaces[i]};
+    Samples const samples{Sample<3>(b_spline)};
+    if (i == 0) {
+      typename BSpline<3>::RefinementPlan_ plan;
+      plan[0].degree_ = 3;
+      plan[0].knots_ = {0.25, 0.75};
+      plan[2].knots_ = {0.5};
+      plan[2].insert_knots_first_ = true;
+      b_spline.Refine(plan);
+    } else {
+      b_spline.ElevateDegree(Dimension{0}, Multiplicity{2});
+      b_spline.RefineKnots(Dimension{0}, {0.25, 0.75});
+      b_spline.InsertKnot(Dimension{2}, 0.5);
+    }
+    EXPECT_LT(MaximumDifference(samples, Sample<3>(b_spline)), kTolerance);
+  }
+  for (int i{}; i < 3; ++i) {
+    EXPECT_EQ(parameter_spaces[0]->GetDegree(i),
+              parameter_spaces[1]->GetDegree(i));
+    EXPECT_EQ(parameter_spaces[0]->GetKnotVector(i)->GetKnots(),
+              parameter_spaces[1]->GetKnotVector(i)->GetKnots());
+  }
+  VectorSpace::Coordinates_ const& planned =
+      std::as_const(*vector_spaces[0]).GetCoordinates();
+  VectorSpace::Coordinates_ const& single =
+      std::as_const(*vector_spaces[1]).GetCoordinates();
+  ASSERT_EQ(planned.size(), single.size());
+  EXPECT_LT(MaximumDifference(planned, single), kTolerance);
+}
+
+// Each side of a split equals the spline on its part of the parametric domain
+// and both sides agree at the knot.
+template<int para_dim, typename Spline>
+void ExpectSplitMatches(Spline const& spline,
+                        Dimension const& dimension,
+                        Type const& knot) {
+  auto const& [first, second] = spline.Split(dimension, knot);
+  int const& split_dimension = dimension;
+  Samples first_part{MakeParametricCoordinates<para_dim>(50)},
+      second_part{first_part}, interface{first_part};
+  for (int i{split_dimension}; i < static_cast<int>(first_part.size());
+       i += para_dim) {
+    first_part[i] *= knot;
+    second_part[i] = knot + second_part[i] * (Type{1} - knot);
+    interface[i] = knot;
+  }
+  EXPECT_LT(MaximumDifference(Sample<para_dim>(spline, first_part),
+                              Sample<para_dim>(*first, first_part)),
+            kTolerance);
+  EXPECT_LT(MaximumDifference(Sample<para_dim>(spline, second_part),
+                              Sample<para_dim>(*second, second_part)),
+            kTolerance);
+  EXPECT_LT(MaximumDifference(Sample<para_dim>(*first, interface),
+                              Sample<para_dim>(*second, interface)),
+            kTolerance);
+}
+
+TEST(BSplineTest, SplitMatchesSpline) {
+  for (Degree degree{1}; degree <= 3; ++degree) {
+    SharedPointer<BSpline<2>> const b_spline{MakeBSpline<2>(
+        {degree + 1, degree}, {{{0.25, 0.5, 0.5, 0.75}, {0.3, 0.6}}}, 3)};
+    for (int dimension{}; dimension < 2; ++dimension) {
+      for (Type const knot : {0.1, 0.3, 0.5, 0.6, 0.75}) {
+        ExpectSplitMatches<2>(*b_spline, Dimension{dimension}, knot);
+      }
+    }
+    SharedPointer<Nurbs<3>> const nurbs{
+        MakeNurbs<3>({degree, 2, 1}, {{{0.5}, {0.5}, {0.4}}}, 2)};
+    for (int dimension{}; dimension < 3; ++dimension) {
+      ExpectSplitMatches<3>(*nurbs, Dimension{dimension}, 0.5);
+    }
+  }
+}
+
+// A knot of full multiplicity needs no insertion.
+TEST(BSplineTest, SplitAtKnotOfFullMultiplicity) {
+  SharedPointer<BSpline<1>> const b_spline{MakeBSpline<1>({2}, {{{0.5}}}, 2)};
+  b_spline->InsertKnot(Dimension{0}, 0.5, Multiplicity{2});
+  ExpectSplitMatches<1>(*b_spline, Dimension{0}, 0.5);
+}
+
+TEST(BSplineTest, SplitAtBoundaryThrows) {
+  SharedPointer<BSpline<1>> const b_spline{MakeBSpline<1>({2}, {{{0.5}}}, 2)};
+  EXPECT_THROW(b_spline->Split(Dimension{0}, 1.0), DomainError);
+  EXPECT_THROW(b_spline->Split(Dimension{0}, 0.0), DomainError);
+}
+
+// Splines whose parameter spaces share knot vectors are refined without
+// inserting knots into the shared knot vectors more than once or changing them
+// for other users.
+TEST(BSplineTest, MakeCompatibleWithSharedKnotVectors) {
+  SharedPointer<ParameterSpace<2>> const first_parameter_space{
+      MakeParameterSpace<2>({2, 2}, {{{0.5}, {0.5}}})};
+  SharedPointer<KnotVector> const shared_knot_vector{
+      first_parameter_space->GetKnotVector(0)};
+  int const number_of_knots{shared_knot_vector->GetSize()};
+  Array<SharedPointer<ParameterSpace<2>>, 3> const parameter_spaces{
+      first_parameter_space,
+      std::make_shared<ParameterSpace<2>>(
+          first_parameter_space->GetKnotVectors(),
+          first_parameter_space->GetDegrees()),
+      MakeParameterSpace<2>({3, 2}, {{{0.25, 0.5}, {0.5}}})};
+  Vector<SharedPointer<BSpline<2>>> b_splines;
+  Vector<Samples> samples;
+  for (SharedPointer<ParameterSpace<2>> const& parameter_space :
+       parameter_spaces) {
+    b_splines.push_back(std::make_shared<BSpline<2>>(
+        parameter_space,
+        std::make_shared<VectorSpace>(MakeCoordinates(*parameter_space, 2))));
+    samples.push_back(Sample<2>(*b_splines.back()));
+  }
+
+  Spline<2>::MakeCompatible({b_splines.begin(), b_splines.end()}, Dimension{0},
+                            2);
+  for (int i{}; i < 3; ++i) {
+    EXPECT_LT(MaximumDifference(samples[i], Sample<2>(*b_splines[i])),
+              kTolerance);
+    EXPECT_EQ(parameter_spaces[i]->GetDegree(0), 3);
+    EXPECT_EQ(parameter_spaces[i]->GetKnotVector(0)->GetKnots(),
+              parameter_spaces[2]->GetKnotVector(0)->GetKnots());
+  }
+  EXPECT_EQ(shared_knot_vector->GetSize(), number_of_knots);
+}
+
+TEST(BSplineTest, MakeCompatibleWithSharedParameterSpaceThrows) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({2, 2}, {{{0.5}, {0.5}}}, 2)};
+  EXPECT_THROW(Spline<2>::MakeCompatible({b_spline, b_spline}, Dimension{0}),
+               DomainError);
+}
+
+// Refining a copy of a spline leaves the original unchanged.
+TEST(BSplineTest, RefiningCopyKeepsOriginal) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({2, 2}, {{{0.5}, {0.3}}}, 3)};
+  Samples const b_spline_samples{Sample<2>(*b_spline)};
+  BSpline<2> const b_spline_copy{*b_spline};
+  b_spline_copy.InsertKnot(Dimension{0}, 0.25);
+  EXPECT_EQ(MaximumDifference(b_spline_samples, Sample<2>(*b_spline)),
+            Type{0});
+  EXPECT_LT(MaximumDifference(b_spline_samples, Sample<2>(b_spline_copy)),
+            kTolerance);
+
+  SharedPointer<Nurbs<2>> const nurbs{
+      MakeNurbs<2>({2, 2}, {{{0.5}, {0.3}}}, 3)};
+  Samples const nurbs_samples{Sample<2>(*nurbs)};
+  Nurbs<2> const nurbs_copy{*nurbs};
+  nurbs_copy.ElevateDegree(Dimension{1});
+  EXPECT_EQ(MaximumDifference(nurbs_samples, Sample<2>(*nurbs)), Type{0});
+  EXPECT_LT(MaximumDifference(nurbs_samples, Sample<2>(nurbs_copy)),
+            kTolerance);
+}
+
+// Batches evaluate the same values as single evaluations in either order.
+TEST(BSplineTest, EvaluateBatchMatchesEvaluate) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({3, 2}, {{{0.2, 0.4, 0.6}, {0.5}}}, 3)};
+  SharedPointer<Nurbs<2>> const nurbs{
+      MakeNurbs<2>({2, 2}, {{{0.4}, {0.3, 0.3}}}, 3)};
+  Samples const parametric_coordinates{MakeParametricCoordinates<2>(500)};
+  Samples const b_spline_expected{Sample<2>(*b_spline, parametric_coordinates)},
+      nurbs_expected{Sample<2>(*nurbs, parametric_coordinates)};
+  Samples evaluated(b_spline_expected.size());
+  for (bool const order_by_element : {false, true}) {
+    b_spline->EvaluateBatch(parametric_coordinates.data(), 500,
+                            evaluated.data(), 4, order_by_element);
+    EXPECT_LT(MaximumDifference(b_spline_expected, evaluated), kTolerance);
+    nurbs->EvaluateBatch(parametric_coordinates.data(), 500, evaluated.data(),
+                         4, order_by_element);
+    EXPECT_LT(MaximumDifference(nurbs_expected, evaluated), kTolerance);
+  }
+}
+
+// Splines viewing the caller's knots and coordinates evaluate and refine the
+// same way as splines owning copies of them.
+TEST(BSplineTest, ViewsOfCallersData) {
+  SharedPointer<ParameterSpace<2>> const parameter_space{
+      MakeParameterSpace<2>({2, 3}, {{{0.3, 0.6, 0.6}, {0.5}}})};
+  Index const number_of_coordinates{
+      parameter_space->GetTotalNumberOfBasisFunctions()};
+  Array<Vector<Type>, 2> knots{parameter_space->GetKnotVector(0)->GetKnots(),
+                               parameter_space->GetKnotVector(1)->GetKnots()};
+  Array<Vector<Type>, 2> const original_knots{knots};
+  auto const make_view_parameter_space = [&] {
+    typename ParameterSpace<2>::KnotVectors_ knot_vectors;
+    for (int i{}; i < 2; ++i) {
+      knot_vectors[i] = std::make_shared<KnotVector>(KnotVector::MakeView(
+          knots[i].data(), static_cast<int>(knots[i].size())));
+    }
+    return std::make_shared<ParameterSpace<2>>(knot_vectors,
+                                               parameter_space->GetDegrees());
+  };
+
+  VectorSpace::Coordinates_ const coordinates{
+      MakeCoordinates(*parameter_space, 3)};
+  Vector<Type> data{coordinates.begin(), coordinates.end()};
+  Vector<Type> const original_data{data};
+  BSpline<2> const b_spline{parameter_space,
+                            std::make_shared<VectorSpace>(coordinates)};
+  SharedPointer<ParameterSpace<2>> const view_parameter_space{
+      make_view_parameter_space()};
+  SharedPointer<VectorSpace> const view_vector_space{
+      std::make_shared<VectorSpace>(data.data(), number_of_coordinates,
+                                    Index{3})};
+  BSpline<2> view{view_parameter_space, view_vector_space};
+  EXPECT_EQ(std::as_const(*view_vector_space).GetCoordinates().data(),
+            data.data());
+  EXPECT_FALSE(view_parameter_space->GetKnotVector(0)->OwnsData());
+  EXPECT_LT(MaximumDifference(Sample<2>(b_spline), Sample<2>(view)),
+            kTolerance);
+  auto const& [patches, bounds] = b_spline.ExtractBezierPatches();
+  auto const& [view_patches, view_bounds] = view.ExtractBezierPatches();
+  EXPECT_LT(MaximumDifference(patches, view_patches), kTolerance);
+  EXPECT_EQ(MaximumDifference(bounds, view_bounds), Type{0});
+  view.UsePackedElementCoordinates(true);
+  EXPECT_LT(MaximumDifference(Sample<2>(b_spline), Sample<2>(view)),
+            kTolerance);
+
+  // Refinement adopts copies, i.e., the caller's data is left unchanged.
+  b_spline.InsertKnot(Dimension{0}, 0.45);
+  view.InsertKnot(Dimension{0}, 0.45);
+  EXPECT_TRUE(view_parameter_space->GetKnotVector(0)->OwnsData());
+  EXPECT_EQ(knots, original_knots);
+  EXPECT_EQ(data, original_data);
+  EXPECT_LT(MaximumDifference(Sample<2>(b_spline), Sample<2>(view)),
+            kTolerance);
+
+  // NURBS view homogeneous coordinates (x, y, z, w).
+  WeightedVectorSpace::Weights_ weights(number_of_coordinates);
+  Vector<Type> weighted_data(number_of_coordinates * 4);
+  for (Index i{}; i < number_of_coordinates; ++i) {
+    weights[i] = Type{0.5} + original_data[i * 3];
+    for (int j{}; j < 3; ++j) {
+      weighted_data[i * 4 + j] = original_data[i * 3 + j];
+    }
+    weighted_data[i * 4 + 3] = weights[i];
+  }
+  WeightedVectorSpace::Homogenize(weighted_data.data(), number_of_coordinates,
+                                  3);
+  Nurbs<2> const nurbs{
+      std::make_shared<ParameterSpace<2>>(*make_view_parameter_space()),
+      std::make_shared<WeightedVectorSpace>(coordinates, weights)};
+  Nurbs<2> const nurbs_view{
+      make_view_parameter_space(),
+      std::make_shared<WeightedVectorSpace>(weighted_data.data(),
+                                            number_of_coordinates, Index{4})};
+  EXPECT_LT(MaximumDifference(Sample<2>(nurbs), Sample<2>(nurbs_view)),
+            kTolerance);
+  Type const parametric_coordinate[2]{0.4, 0.7};
+  int const derivative[2]{1, 1};
+  EXPECT_LT(MaximumDifference(nurbs(parametric_coordinate, derivative),
+                              nurbs_view(parametric_coordinate, derivative)),
+            Type{100} * kTolerance);
+}
+
+} // namespace
+} // namespace bsplinelib::splines
@@ -0,0 +1,187 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/hierarchical_parameter_space.hpp"
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Splines/hierarchical_b_spline.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::splines {
+namespace {
+
+using parameter_spaces::KnotVector;
+using vector_spaces::VectorSpace;
+using ParameterSpace = parameter_spaces::ParameterSpace<2>;
+using HierarchicalParameterSpace =
+    parameter_spaces::HierarchicalParameterSpace<2>;
+using Samples = Vector<Type>;
+
+constexpr Type const kTolerance{Type{1000}
+                                * std::numeric_limits<Type>::epsilon()};
+constexpr int const kNumberOfSamples{200};
+
+// Open parameter space on [0, 1]^2 with given interior knots.
+SharedPointer<ParameterSpace>
+MakeParameterSpace(Array<Degree, 2> const& degrees,
+                   Array<Vector<Type>, 2> const& interior_knots) {
+  ParameterSpace::KnotVectors_ knot_vectors;
+  for (int i{}; i < 2; ++i) {
+    Vector<Type> knots(degrees[i] + 1, Type{0});
+    knots.insert(knots.end(), interior_knots[i].begin(),
+                 interior_knots[i].end());
+    knots.insert(knots.end(), degrees[i] + 1, Type{1});
+    knot_vectors[i] = std::make_shared<KnotVector>(knots);
+  }
+  return std::make_shared<ParameterSpace>(knot_vectors, degrees);
+}
+
+VectorSpace::Coordinates_ MakeCoordinates(ParameterSpace const& parameter_space,
+                                          int const& dim) {
+  std::mt19937 random_number_generator{42};
+  std::uniform_real_distribution<Type> distribution{};
+  VectorSpace::Coordinates_ coordinates(
+      parameter_space.GetTotalNumberOfBasisFunctions(), dim);
+  for (Type& coordinate : coordinates) {
+    coordinate = distribution(random_number_generator);
+  }
+  return coordinates;
+}
+
+Samples MakeParametricCoordinates() {
+  std::mt19937 random_number_generator{7};
+  std::uniform_real_distribution<Type> distribution{};
+  Samples parametric_coordinates(2 * kNumberOfSamples);
+  for (Type& parametric_coordinate : parametric_coordinates) {
+    parametric_coordinate = distribution(random_number_generator);
+  }
+  return parametric_coordinates;
+}
+
+template<typename Spline>
+Samples Sample(Spline const& spline) {
+  Samples const parametric_coordinates{MakeParametricCoordinates()};
+  int const dim{spline.Dim()};
+  Samples evaluated(kNumberOfSamples * dim);
+  for (int i{}; i < kNumberOfSamples; ++i) {
+    spline.Evaluate(&parametric_coordinates[2 * i], &evaluated[i * dim]);
+  }
+  return evaluated;
+}
+
+Type MaximumDifference(Samples const& lhs, Samples const& rhs) {
+  Type maximum_difference{};
+  for (std::size_t i{}; i < lhs.size(); ++i) {
+    maximum_difference =
+        std::max(maximum_difference, std::abs(lhs[i] - rhs[i]));
+  }
+  return maximum_difference;
+}
+
+// Truncated basis functions are non-negative, sum up to one, and their
+// derivatives sum up to zero.
+TEST(HierarchicalParameterSpaceTest, FormsPartitionOfUnity) {
+  HierarchicalParameterSpace parameter_space{
+      *MakeParameterSpace({2, 2}, {{{0.25, 0.5, 0.75}, {0.5}}})};
+  Index const number_of_basis_functions{
+      parameter_space.GetTotalNumberOfBasisFunctions()};
+  parameter_space.RefineElements(0, {0, 1, 4});
+  parameter_space.RefineElements(1, {0, 1});
+  EXPECT_EQ(parameter_space.GetNumberOfLevels(), 3);
+  EXPECT_GT(parameter_space.GetTotalNumberOfBasisFunctions(),
+            number_of_basis_functions);
+
+  Samples const parametric_coordinates{MakeParametricCoordinates()};
+  int const derivative[2]{1, 0};
+  for (int i{}; i < kNumberOfSamples; ++i) {
+    auto const& [functions, values] =
+        parameter_space.EvaluateBasisValues(&parametric_coordinates[2 * i]);
+    Type sum{};
+    for (Type const& value : values) {
+      EXPECT_GT(value, -kTolerance);
+      sum += value;
+    }
+    EXPECT_NEAR(sum, Type{1}, kTolerance);
+    auto const& [derivative_functions, derivative_values] =
+        parameter_space.EvaluateBasisDerivativeValues(
+            &parametric_coordinates[2 * i], derivative);
+    Type derivative_sum{};
+    for (Type const& value : derivative_values) { derivative_sum += value; }
+    EXPECT_NEAR(derivative_sum, Type{0}, Type{100} * kTolerance);
+  }
+}
+
+TEST(HierarchicalBSplineTest, RefineElementsKeepsGeometry) {
+  SharedPointer<ParameterSpace> const parameter_space{
+      MakeParameterSpace({2, 3}, {{{0.25, 0.5, 0.75}, {0.5}}})};
+  SharedPointer<VectorSpace> const vector_space{std::make_shared<VectorSpace>(
+      MakeCoordinates(*parameter_space, 3))};
+  BSpline<2> const reference{parameter_space, vector_space};
+  HierarchicalBSpline<2> hierarchical_b_spline{*parameter_space, vector_space};
+  Samples const expected{Sample(reference)};
+  EXPECT_LT(MaximumDifference(expected, Sample(hierarchical_b_spline)),
+            kTolerance);
+
+  hierarchical_b_spline.RefineElements(0, {0, 1, 5});
+  hierarchical_b_spline.RefineElements(1, {0, 1, 8});
+  EXPECT_EQ(hierarchical_b_spline.GetParameterSpace()->GetNumberOfLevels(), 3);
+  EXPECT_EQ(hierarchical_b_spline.GetVectorSpace()->GetNumberOfCoordinates(),
+            hierarchical_b_spline.GetParameterSpace()
+                ->GetTotalNumberOfBasisFunctions());
+  EXPECT_LT(MaximumDifference(expected, Sample(hierarchical_b_spline)),
+            kTolerance);
+}
+
+// Refinement replaces the parameter and vector space of the refined spline
+// only.
+TEST(HierarchicalBSplineTest, RefineElementsCopiesSharedSpaces) {
+  SharedPointer<ParameterSpace> const parameter_space{
+      MakeParameterSpace({2, 2}, {{{0.25, 0.5, 0.75}, {0.5}}})};
+  SharedPointer<HierarchicalParameterSpace> const hierarchical_parameter_space{
+      std::make_shared<HierarchicalParameterSpace>(*parameter_space)};
+  SharedPointer<VectorSpace> const vector_space{std::make_shared<VectorSpace>(
+      MakeCoordinates(*parameter_space, 2))};
+  HierarchicalBSpline<2> refined{hierarchical_parameter_space, vector_space},
+      shared{hierarchical_parameter_space, vector_space};
+  Samples const expected{Sample(shared)};
+
+  refined.RefineElements(0, {0, 1});
+  EXPECT_EQ(shared.GetParameterSpace(), hierarchical_parameter_space);
+  EXPECT_EQ(shared.GetVectorSpace(), vector_space);
+  EXPECT_EQ(hierarchical_parameter_space->GetNumberOfLevels(), 1);
+  EXPECT_LT(MaximumDifference(expected, Sample(refined)), kTolerance);
+  EXPECT_LT(MaximumDifference(expected, Sample(shared)), kTolerance);
+
+  HierarchicalParameterSpace copy{*refined.GetParameterSpace()};
+  copy.RefineElements(1, {0});
+  EXPECT_EQ(refined.GetParameterSpace()->GetNumberOfLevels(), 2);
+  EXPECT_EQ(copy.GetNumberOfLevels(), 3);
+}
+
+} // namespace
+} // namespace bsplinelib::splines
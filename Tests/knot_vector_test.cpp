@@ -0,0 +1,117 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+
+namespace bsplinelib::parameter_spaces {
+namespace {
+
+using Knots = KnotVector::Knots_;
+
+// Each unique knot is kept with the maximum of its multiplicities.
+TEST(KnotVectorTest, DetermineUnion) {
+  KnotVector const knot_vector{KnotVector::DetermineUnion(
+      {std::make_shared<KnotVector>(Knots{0.0, 0.0, 0.5, 0.5, 1.0, 1.0}),
+       std::make_shared<KnotVector>(Knots{0.0, 0.0, 0.25, 0.5, 1.0, 1.0}),
+       std::make_shared<KnotVector>(
+           Knots{0.0, 0.0, 0.0, 0.75, 0.75, 0.75, 1.0, 1.0, 1.0})})};
+  EXPECT_EQ(knot_vector.GetKnots(),
+            (Knots{0.0, 0.0, 0.0, 0.25, 0.5, 0.5, 0.75, 0.75, 0.75, 1.0, 1.0,
+                   1.0}));
+}
+
+TEST(KnotVectorTest, DetermineMissingKnots) {
+  KnotVector const knot_vector{{0.0, 0.0, 0.5, 1.0, 1.0}},
+      superset{{0.0, 0.0, 0.0, 0.25, 0.5, 0.5, 1.0, 1.0, 1.0}};
+  EXPECT_EQ(knot_vector.DetermineMissingKnots(superset),
+            (Knots{0.0, 0.25, 0.5, 1.0}));
+  EXPECT_TRUE(superset.DetermineMissingKnots(superset).empty());
+}
+
+// Copies share the knots until either of them is modified.
+TEST(KnotVectorTest, CopiesShareKnotsUntilModified) {
+  KnotVector const knot_vector{{0.0, 0.0, 0.5, 1.0, 1.0}};
+  KnotVector inserted{knot_vector}, scaled{knot_vector};
+  EXPECT_EQ(inserted.GetData(), knot_vector.GetData());
+  EXPECT_EQ(inserted.GetRevision(), knot_vector.GetRevision());
+
+  inserted.Insert(0.25);
+  EXPECT_NE(inserted.GetData(), knot_vector.GetData());
+  EXPECT_NE(inserted.GetRevision(), knot_vector.GetRevision());
+  EXPECT_EQ(knot_vector.GetSize(), 5);
+  EXPECT_EQ(inserted.GetSize(), 6);
+  scaled.Scale(0.0, 2.0);
+  EXPECT_EQ(knot_vector.GetBack(), 1.0);
+  EXPECT_EQ(scaled.GetBack(), 2.0);
+}
+
+// Moved-from knot vectors own empty knots and can be assigned to.
+TEST(KnotVectorTest, MovedFromKnotVectorsAreEmpty) {
+  KnotVector knot_vector{{0.0, 0.0, 1.0, 1.0}};
+  KnotVector moved{std::move(knot_vector)};
+  EXPECT_EQ(moved.GetSize(), 4);
+  EXPECT_EQ(knot_vector.GetSize(), 0); // NOLINT(bugprone-use-after-move)
+  knot_vector = KnotVector{{0.0, 1.0}};
+  EXPECT_EQ(knot_vector.GetKnots(), (Knots{0.0, 1.0}));
+}
+
+// Views read and write through to the caller's knots until the number of
+// knots changes.
+TEST(KnotVectorTest, ViewsOfCallersKnots) {
+  Knots knots{0.0, 0.0, 0.0, 0.5, 0.5, 1.0, 1.0, 1.0};
+  Knots const original{knots};
+  KnotVector knot_vector{KnotVector::MakeView(knots.data(), 8)};
+  KnotVector const& view = knot_vector;
+  EXPECT_FALSE(view.OwnsData());
+  EXPECT_EQ(view.GetData(), knots.data());
+  KnotVector::ConstKnots_ const view_knots{view.GetKnotRange()};
+  EXPECT_EQ(view_knots.data(), knots.data());
+  EXPECT_EQ(Knots(view_knots.begin(), view_knots.end()), original);
+  EXPECT_THROW(view.GetKnots(), RuntimeError);
+  EXPECT_EQ(view.DetermineMultiplicity(0.5), 2);
+  EXPECT_EQ(view.GetUniqueKnots().size(), 3);
+
+  KnotVector const copy{view};
+  EXPECT_TRUE(copy.OwnsData());
+  EXPECT_NE(copy.GetData(), knots.data());
+
+  knot_vector.UpdateKnot(3, 0.25);
+  EXPECT_EQ(knots[3], 0.25);
+  knot_vector.UpdateKnot(3, 0.5);
+  knot_vector.Scale(0.0, 2.0);
+  EXPECT_EQ(knots.back(), 2.0);
+  knot_vector.Scale(0.0, 1.0);
+  EXPECT_FALSE(knot_vector.OwnsData());
+
+  // Changing the number of knots adopts them, i.e., the caller's knots are
+  // neither changed nor viewed anymore.
+  knot_vector.Insert(0.25);
+  EXPECT_TRUE(knot_vector.OwnsData());
+  EXPECT_EQ(knot_vector.GetSize(), 9);
+  EXPECT_EQ(knots, original);
+}
+
+} // namespace
+} // namespace bsplinelib::parameter_spaces
@@ -0,0 +1,181 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::parameter_spaces {
+namespace {
+
+using splines::BSpline;
+using vector_spaces::VectorSpace;
+using Knots = Vector<Type>;
+
+constexpr Type const kTolerance{Type{1000}
+                                * std::numeric_limits<Type>::epsilon()};
+
+// Open parameter space on [0, 1]^para_dim with given interior knots.
+template<int para_dim>
+SharedPointer<ParameterSpace<para_dim>>
+MakeParameterSpace(Array<Degree, para_dim> const& degrees,
+                   Array<Knots, para_dim> const& interior_knots) {
+  typename ParameterSpace<para_dim>::KnotVectors_ knot_vectors;
+  for (int i{}; i < para_dim; ++i) {
+    Knots knots(degrees[i] + 1, Type{0});
+    knots.insert(knots.end(), interior_knots[i].begin(),
+                 interior_knots[i].end());
+    knots.insert(knots.end(), degrees[i] + 1, Type{1});
+    knot_vectors[i] = std::make_shared<KnotVector>(knots);
+  }
+  return std::make_shared<ParameterSpace<para_dim>>(knot_vectors, degrees);
+}
+
+// The coordinates of the refined spline are the prolongation of the coarse
+// ones, i.e., P c.
+template<int para_dim, typename Refine>
+void ExpectProlongationYieldsRefinedCoordinates(
+    Array<Degree, para_dim> const& degrees,
+    Array<Knots, para_dim> const& interior_knots,
+    Refine const& refine) {
+  SharedPointer<ParameterSpace<para_dim>> const parameter_space{
+      MakeParameterSpace<para_dim>(degrees, interior_knots)};
+  std::mt19937 random_number_generator{42};
+  std::uniform_real_distribution<Type> distribution{};
+  VectorSpace::Coordinates_ coarse_coordinates(
+      parameter_space->GetTotalNumberOfBasisFunctions(), 3);
+  for (Type& coordinate : coarse_coordinates) {
+    coordinate = distribution(random_number_generator);
+  }
+  SharedPointer<VectorSpace> const vector_space{
+      std::make_shared<VectorSpace>(coarse_coordinates)};
+  BSpline<para_dim> const b_spline{parameter_space, vector_space};
+  ParameterSpace<para_dim> const coarse{*parameter_space};
+
+  refine(b_spline);
+  VectorSpace::Coordinates_ const& fine_coordinates =
+      std::as_const(*vector_space).GetCoordinates();
+  auto const prolongation = coarse.DetermineProlongation(*parameter_space);
+  ASSERT_EQ(prolongation.number_of_rows_, fine_coordinates.Shape()[0]);
+  ASSERT_EQ(prolongation.number_of_columns_, coarse_coordinates.Shape()[0]);
+  Knots prolongated(fine_coordinates.size());
+  prolongation.Multiply(coarse_coordinates.data(), 3, prolongated.data());
+  for (std::size_t i{}; i < prolongated.size(); ++i) {
+    EXPECT_NEAR(prolongated[i], fine_coordinates[i], kTolerance);
+  }
+}
+
+TEST(ParameterSpaceTest, ProlongationOfKnotInsertion) {
+  ExpectProlongationYieldsRefinedCoordinates<1>(
+      {3}, {{{0.2, 0.5}}}, [](auto const& spline) {
+        spline.InsertKnot(Dimension{0}, 0.3);
+        spline.InsertKnot(Dimension{0}, 0.5, Multiplicity{2});
+      });
+}
+
+TEST(ParameterSpaceTest, ProlongationOfDegreeElevation) {
+  ExpectProlongationYieldsRefinedCoordinates<1>(
+      {2}, {{{0.2, 0.5}}}, [](auto const& spline) {
+        spline.ElevateDegree(Dimension{0}, Multiplicity{2});
+      });
+}
+
+TEST(ParameterSpaceTest, ProlongationOfMixedRefinements) {
+  ExpectProlongationYieldsRefinedCoordinates<2>(
+      {2, 3}, {{{0.3, 0.6}, {0.5, 0.5}}}, [](auto const& spline) {
+        spline.ElevateDegree(Dimension{0});
+        spline.InsertKnot(Dimension{0}, 0.45);
+        spline.InsertKnot(Dimension{1}, 0.2, Multiplicity{2});
+        spline.ElevateDegree(Dimension{1});
+      });
+  ExpectProlongationYieldsRefinedCoordinates<3>(
+      {1, 2, 2}, {{{0.5}, {0.25}, {}}}, [](auto const& spline) {
+        spline.InsertKnot(Dimension{2}, 0.5);
+        spline.ElevateDegree(Dimension{0});
+        spline.InsertKnot(Dimension{1}, 0.6);
+      });
+}
+
+// Spaces that do not contain this one, e.g., with a coarser knot or of lower
+// degree, are rejected.
+TEST(ParameterSpaceTest, ProlongationToNonNestedSpaceThrows) {
+  SharedPointer<ParameterSpace<1>> const coarse{
+      MakeParameterSpace<1>({2}, {{{0.5, 0.5}}})};
+  EXPECT_THROW(
+      coarse->DetermineProlongation(*MakeParameterSpace<1>({2}, {{{0.5}}})),
+      DomainError);
+  EXPECT_THROW(
+      coarse->DetermineProlongation(*MakeParameterSpace<1>({3}, {{{0.5}}})),
+      DomainError);
+  EXPECT_THROW(
+      coarse->DetermineProlongation(*MakeParameterSpace<1>({1}, {{{0.5}}})),
+      DomainError);
+  EXPECT_NO_THROW(coarse->DetermineProlongation(
+      *MakeParameterSpace<1>({3}, {{{0.25, 0.5, 0.5, 0.5}}})));
+}
+
+// The evaluation order is a permutation that visits each element once and
+// keeps the order of coordinates within an element.
+TEST(ParameterSpaceTest, EvaluationOrderGroupsCoordinatesByElement) {
+  SharedPointer<ParameterSpace<2>> const parameter_space{
+      MakeParameterSpace<2>({2, 1}, {{{0.2, 0.4, 0.6}, {0.25, 0.5, 0.75}}})};
+  constexpr Index const kNumberOfParametricCoordinates{200};
+  std::mt19937 random_number_generator{7};
+  std::uniform_real_distribution<Type> distribution{};
+  Knots parametric_coordinates(2 * kNumberOfParametricCoordinates);
+  for (Type& parametric_coordinate : parametric_coordinates) {
+    parametric_coordinate = distribution(random_number_generator);
+  }
+
+  auto const& [order, knot_spans] = parameter_space->DetermineEvaluationOrder(
+      parametric_coordinates.data(), kNumberOfParametricCoordinates);
+  ASSERT_EQ(static_cast<Index>(order.size()), kNumberOfParametricCoordinates);
+  Vector<Index> sorted{order};
+  std::sort(sorted.begin(), sorted.end());
+  for (Index i{}; i < kNumberOfParametricCoordinates; ++i) {
+    EXPECT_EQ(sorted[i], i);
+  }
+  for (Index i{}; i < kNumberOfParametricCoordinates; ++i) {
+    EXPECT_EQ(knot_spans[i], parameter_space->FindEffectiveKnotSpans(
+                                 &parametric_coordinates[2 * order[i]]));
+    if (i == 0) {
+      continue;
+    }
+    if (knot_spans[i] == knot_spans[i - 1]) {
+      EXPECT_LT(order[i - 1], order[i]);
+    } else {
+      EXPECT_EQ(std::find(knot_spans.begin(), knot_spans.begin() + i,
+                          knot_spans[i]),
+                knot_spans.begin() + i);
+    }
+  }
+}
+
+} // namespace
+} // namespace bsplinelib::parameter_spaces
@@ -0,0 +1,175 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "BSplineLib/ParameterSpaces/knot_vector.hpp"
+#include "BSplineLib/ParameterSpaces/parameter_space.hpp"
+#include "BSplineLib/Splines/b_spline.hpp"
+#include "BSplineLib/Splines/static_b_spline.hpp"
+#include "BSplineLib/Utilities/error_handling.hpp"
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::splines {
+namespace {
+
+using parameter_spaces::KnotVector;
+using vector_spaces::VectorSpace;
+template<int para_dim>
+using ParameterSpace = parameter_spaces::ParameterSpace<para_dim>;
+using Samples = Vector<Type>;
+using Patch = StaticBSpline<2, 3, 3, 4, 4>;
+
+constexpr Type const kTolerance{Type{1000}
+                                * std::numeric_limits<Type>::epsilon()};
+constexpr int const kNumberOfSamples{300};
+
+constexpr Patch MakePatch() {
+  Patch::Knots_ const knots{0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1};
+  Patch::Coordinates_ coordinates{};
+  for (int j{}; j < 4; ++j) {
+    for (int i{}; i < 4; ++i) {
+      coordinates[(j * 4 + i) * 3] = i;
+      coordinates[(j * 4 + i) * 3 + 1] = j;
+      coordinates[(j * 4 + i) * 3 + 2] = i * j;
+    }
+  }
+  return Patch{knots, coordinates};
+}
+
+// Evaluation is constexpr; the bilinear patch reproduces (3u, 3v, 9uv).
+constexpr Patch kPatch{MakePatch()};
+constexpr Patch::Coordinate_ kEvaluated{kPatch.Evaluate({0.5, 0.5})};
+static_assert(Patch::kNumberOfNonZeroBasisFunctions == 16
+              && Patch::kNumberOfKnots == 16);
+static_assert(kEvaluated[0] > 1.49 && kEvaluated[0] < 1.51
+              && kEvaluated[2] > 2.24 && kEvaluated[2] < 2.26);
+
+// B-spline on [0, 1]^para_dim with given interior knots and random
+// coordinates.
+template<int para_dim>
+SharedPointer<BSpline<para_dim>>
+MakeBSpline(Array<Degree, para_dim> const& degrees,
+            Array<Vector<Type>, para_dim> const& interior_knots,
+            int const& dim) {
+  typename ParameterSpace<para_dim>::KnotVectors_ knot_vectors;
+  for (int i{}; i < para_dim; ++i) {
+    Vector<Type> knots(degrees[i] + 1, Type{0});
+    knots.insert(knots.end(), interior_knots[i].begin(),
+                 interior_knots[i].end());
+    knots.insert(knots.end(), degrees[i] + 1, Type{1});
+    knot_vectors[i] = std::make_shared<KnotVector>(knots);
+  }
+  SharedPointer<ParameterSpace<para_dim>> parameter_space{
+      std::make_shared<ParameterSpace<para_dim>>(knot_vectors, degrees)};
+  std::mt19937 random_number_generator{42};
+  std::uniform_real_distribution<Type> distribution{};
+  VectorSpace::Coordinates_ coordinates(
+      parameter_space->GetTotalNumberOfBasisFunctions(), dim);
+  for (Type& coordinate : coordinates) {
+    coordinate = distribution(random_number_generator);
+  }
+  return std::make_shared<BSpline<para_dim>>(
+      std::move(parameter_space),
+      std::make_shared<VectorSpace>(std::move(coordinates)));
+}
+
+template<int para_dim, typename Spline>
+Samples Sample(Spline const& spline, Samples const& parametric_coordinates) {
+  int const dim{spline.Dim()};
+  Samples evaluated(kNumberOfSamples * dim);
+  for (int i{}; i < kNumberOfSamples; ++i) {
+    spline.Evaluate(&parametric_coordinates[i * para_dim],
+                    &evaluated[i * dim]);
+  }
+  return evaluated;
+}
+
+Type MaximumDifference(Samples const& lhs, Samples const& rhs) {
+  Type maximum_difference{};
+  for (std::size_t i{}; i < lhs.size(); ++i) {
+    maximum_difference =
+        std::max(maximum_difference, std::abs(lhs[i] - rhs[i]));
+  }
+  return maximum_difference;
+}
+
+// The static B-spline, its conversion back, and the B-spline evaluate the
+// same values and the static basis is a partition of unity.
+template<typename StaticBSplineType, int para_dim>
+void ExpectStaticBSplineMatches(BSpline<para_dim> const& b_spline) {
+  StaticBSplineType const static_b_spline{b_spline};
+  std::mt19937 random_number_generator{7};
+  std::uniform_real_distribution<Type> distribution{};
+  Samples parametric_coordinates(kNumberOfSamples * para_dim);
+  for (Type& parametric_coordinate : parametric_coordinates) {
+    parametric_coordinate = distribution(random_number_generator);
+  }
+  Samples const expected{Sample<para_dim>(b_spline, parametric_coordinates)};
+  Samples evaluated(expected.size());
+  static_b_spline.Evaluate(parametric_coordinates.data(), kNumberOfSamples,
+                           evaluated.data());
+  EXPECT_LT(MaximumDifference(expected, evaluated), kTolerance);
+  EXPECT_LT(MaximumDifference(expected,
+                              Sample<para_dim>(*static_b_spline.ToBSpline(),
+                                               parametric_coordinates)),
+            kTolerance);
+
+  for (int i{}; i < kNumberOfSamples; ++i) {
+    typename StaticBSplineType::ParametricCoordinate_ parametric_coordinate;
+    for (int j{}; j < para_dim; ++j) {
+      parametric_coordinate[j] = parametric_coordinates[i * para_dim + j];
+    }
+    Type sum{};
+    for (Type const& value :
+         static_b_spline.EvaluateBasisValues(parametric_coordinate)) {
+      sum += value;
+    }
+    EXPECT_NEAR(sum, Type{1}, kTolerance);
+  }
+}
+
+TEST(StaticBSplineTest, MatchesBSpline) {
+  ExpectStaticBSplineMatches<StaticBSpline<2, 2, 3, 6, 4>>(
+      *MakeBSpline<2>({2, 2}, {{{0.3, 0.6, 0.6}, {0.5}}}, 3));
+  ExpectStaticBSplineMatches<StaticBSpline<1, 0, 2, 4>>(
+      *MakeBSpline<1>({0}, {{{0.25, 0.5, 0.75}}}, 2));
+  ExpectStaticBSplineMatches<StaticBSpline<1, 3, 3, 8>>(
+      *MakeBSpline<1>({3}, {{{0.1, 0.2, 0.2, 0.9}}}, 3));
+  ExpectStaticBSplineMatches<StaticBSpline<3, 1, 1, 3, 2, 4>>(
+      *MakeBSpline<3>({1, 1, 1}, {{{0.5}, {}, {0.3, 0.7}}}, 1));
+}
+
+TEST(StaticBSplineTest, ShapeMismatchThrows) {
+  SharedPointer<BSpline<2>> const b_spline{
+      MakeBSpline<2>({2, 2}, {{{0.3, 0.6, 0.6}, {0.5}}}, 3)};
+  using WrongDegree = StaticBSpline<2, 3, 3, 6, 5>;
+  using WrongDim = StaticBSpline<2, 2, 2, 6, 4>;
+  EXPECT_THROW(WrongDegree{*b_spline}, InvalidArgument);
+  EXPECT_THROW(WrongDim{*b_spline}, InvalidArgument);
+}
+
+} // namespace
+} // namespace bsplinelib::splines
@@ -0,0 +1,58 @@
+/* Copyright (c) 2018–2021 SplineLib
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "BSplineLib/VectorSpaces/vector_space.hpp"
+
+namespace bsplinelib::vector_spaces {
+namespace {
+
+VectorSpace MakeVectorSpace() {
+  VectorSpace::Coordinates_ coordinates(4, 2);
+  for (int i{}; i < 8; ++i) { coordinates[i] = i; }
+  return VectorSpace{std::move(coordinates)};
+}
+
+// Copies share the coordinates until either of them is modified.
+TEST(VectorSpaceTest, CopiesShareCoordinatesUntilModified) {
+  VectorSpace const vector_space{MakeVectorSpace()};
+  VectorSpace copy{vector_space};
+  EXPECT_EQ(&std::as_const(copy).GetCoordinates(),
+            &vector_space.GetCoordinates());
+  EXPECT_EQ(copy.GetRevision(), vector_space.GetRevision());
+
+  copy.MakeCoordinatesUnique();
+  copy[1][0] = 100.0;
+  EXPECT_NE(&std::as_const(copy).GetCoordinates(),
+            &vector_space.GetCoordinates());
+  EXPECT_NE(copy.GetRevision(), vector_space.GetRevision());
+  EXPECT_EQ(vector_space[1][0], 2.0);
+  EXPECT_EQ(std::as_const(copy)[1][0], 100.0);
+
+  VectorSpace erased{vector_space};
+  erased.Erase(0);
+  EXPECT_EQ(vector_space.GetNumberOfCoordinates(), 4);
+  EXPECT_EQ(erased.GetNumberOfCoordinates(), 3);
+}
+
+} // namespace
+} // namespace bsplinelib::vector_spaces